@@ -5,6 +5,7 @@ if(DUAL_ENDPOINT_MODE)
     # 添加双端模式专用源代码
     file(GLOB_RECURSE DUAL_SOURCES
         ${CMAKE_CURRENT_SOURCE_DIR}/src/impl/*.cpp
+        ${CMAKE_CURRENT_SOURCE_DIR}/src/impl/*.c
     )
     target_sources(${PROJECT_NAME} PRIVATE ${DUAL_SOURCES})
     
@@ -32,9 +33,30 @@ if (THREAD_POOL_MODE)
         list(APPEND PROJECT_HEADER_DIR ${CMAKE_CURRENT_SOURCE_DIR}/src/expand/threadpool/pthread)
     endif()
 
+    # 跨平台的任务窃取调度
+    file(GLOB THREADPOOL_COMMON_SOURCES
+        ${CMAKE_CURRENT_SOURCE_DIR}/src/expand/threadpool/*.cc
+    )
+    target_sources(${PROJECT_NAME} PRIVATE ${THREADPOOL_COMMON_SOURCES})
     list(APPEND PROJECT_HEADER_DIR ${CMAKE_CURRENT_SOURCE_DIR}/src/expand/threadpool)
 endif()
 
+# 使用io_uring收发后端（直接使用系统调用，不依赖liburing）
+if (IO_URING_MODE)
+    if (CMAKE_SYSTEM_NAME STREQUAL "Linux")
+        message(STATUS "Building with IO_URING_MODE")
+
+        file(GLOB_RECURSE IO_URING_SOURCES
+            ${CMAKE_CURRENT_SOURCE_DIR}/src/expand/io_uring/*.cpp
+        )
+        target_sources(${PROJECT_NAME} PRIVATE ${IO_URING_SOURCES})
+        list(APPEND PROJECT_HEADER_DIR ${CMAKE_CURRENT_SOURCE_DIR}/src/expand/io_uring)
+    else()
+        message(WARNING "IO_URING_MODE is only supported on Linux, ignored")
+        set(IO_URING_MODE OFF)
+    endif()
+endif()
+
 # 使用logger
 if (ENABLE_LOGGING)
     message(STATUS "Building with ENABLE_LOGGING")
@@ -68,5 +90,6 @@ endif()
 target_compile_definitions(${PROJECT_NAME} PRIVATE
     $<$<BOOL:${DUAL_ENDPOINT_MODE}>:DUAL_ENDPOINT_MODE>
     $<$<BOOL:${THREAD_POOL_MODE}>:THREAD_POOL_MODE>
+    $<$<BOOL:${IO_URING_MODE}>:IO_URING_MODE>
     $<$<BOOL:${ENABLE_LOGGING}>:ENABLE_LOGGING>
 )
\ No newline at end of file
@@ -119,18 +119,19 @@ int Destroy()
 
 int BroadcastMessage(void *pData, size_t size)
 {
-    static auto send_list = SingletonTemplate<ConfigWrapper>::getSingletonInstance().getCfgInstance().
-                        getList<ConfigInterface::CommInfo>("send_list");
-    
-    auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
-    int ret = 0;
-    for (const auto &target : send_list)
-    {
-        if (!communicateImp.send(target.IP, target.Port, pData, size))
-            ret = -1;
-    }
+    static auto send_list = [] {
+        std::vector<std::pair<std::string, int>> dest_list;
+        for (const auto &target : SingletonTemplate<ConfigWrapper>::getSingletonInstance().getCfgInstance().
+                                  getList<ConfigInterface::CommInfo>("send_list"))
+        {
+            dest_list.emplace_back(target.IP, target.Port);
+        }
+        return dest_list;
+    }();
 
-    return ret;
+    auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
+    // 所有目标一次批量发送，失败的目标由实现层记录日志
+    return communicateImp.sendBatch(send_list, pData, size) == 0 ? 0 : -1;
 }
 
 int SendGeneralMessage(const char* addr, int port, void *pData, size_t size)
@@ -144,6 +145,77 @@ int SendGeneralMessage(const char* addr, int port, void *pData, size_t size)
     return 0;
 }
 
+int SendAsync(const char* addr, int port, const void *pData, size_t size,
+              SendCompletion callback, void *user_ctx)
+{
+    if (!addr || !pData)
+    {
+        return -3;
+    }
+    auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
+    return communicateImp.sendAsync(addr, port, pData, size, callback, user_ctx);
+}
+
+int SendGeneralMessageV(const char* addr, int port, const iovec *iov, int iovcnt)
+{
+    if (!addr || !iov || iovcnt <= 0)
+    {
+        return -1;
+    }
+    auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
+    if (!communicateImp.sendv(addr, port, iov, iovcnt))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+int SendOwnedMessage(const char* addr, int port, std::shared_ptr<const void> pData, size_t size)
+{
+    auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
+    if (!addr || !pData || !communicateImp.sendOwned(addr, port, std::move(pData), size))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+Endpoint ResolveEndpoint(const char* addr, int port)
+{
+    auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
+    return Endpoint(communicateImp.resolveEndpoint(addr ? addr : "", port));
+}
+
+int SendTo(const Endpoint &endpoint, void *pData, size_t size)
+{
+    if (!endpoint.valid())
+    {
+        return -1;
+    }
+    auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
+    auto *handle = static_cast<const CommunicateInterface::EndpointHandle *>(endpoint.handle().get());
+    if (!communicateImp.sendTo(*handle, pData, size))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+int SendTo(const Endpoint &endpoint, std::shared_ptr<const void> pData, size_t size)
+{
+    if (!endpoint.valid() || !pData)
+    {
+        return -1;
+    }
+    auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
+    auto *handle = static_cast<const CommunicateInterface::EndpointHandle *>(endpoint.handle().get());
+    if (!communicateImp.sendOwnedTo(*handle, std::move(pData), size))
+    {
+        return -1;
+    }
+    return 0;
+}
+
 int AddPeriodicSendTask(const char* addr, int port, void *pData, size_t size, int rate, int task_id)
 {
     auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
@@ -158,6 +230,16 @@ int RemovePeriodicSendTask(int task_id)
     return communicateImp.removePeriodicTask(task_id);
 }
 
+int GetPeriodicSendTaskStats(int task_id, PeriodicTaskStats *stats)
+{
+    if (!stats)
+    {
+        return -1;
+    }
+    auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
+    return communicateImp.periodicTaskStats(task_id, *stats);
+}
+
 int Subscribe(SubscribebBase *pSubscribe)
 {
     auto &communicateImp = SingletonTemplate<SocketWrapper>::getSingletonInstance().getCommunicateImp();
@@ -16,11 +16,28 @@ Version history
 #ifndef COMMUNICATE_API_H
 #define COMMUNICATE_API_H
 
+#include <cstdint>
 #include <memory>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
 
 namespace communicate
 {
 
+#ifdef _WIN32
+/* 分散数据片段（与POSIX iovec字段一致） */
+struct iovec
+{
+    void *iov_base;
+    size_t iov_len;
+};
+#else
+using ::iovec;
+#endif
+
 /* 消息抽象基类，使用时继承重载其中消息处理函数进行解析 */
 class SubscribebBase
 {
@@ -37,6 +54,42 @@ public:
     virtual int handleMsg(std::shared_ptr<void> msg) = 0;
 };
 
+/* 预先解析的发送目标（由 ResolveEndpoint 获得），可复制并在线程间共享
+   内部持有解析后的地址及发送socket，发送时不再解析地址字符串 */
+class Endpoint
+{
+public:
+    Endpoint() = default;
+    explicit Endpoint(std::shared_ptr<const void> handle) : handle_(std::move(handle)) {}
+
+    // 解析失败时为false
+    bool valid() const { return handle_ != nullptr; }
+    const std::shared_ptr<const void> &handle() const { return handle_; }
+
+private:
+    std::shared_ptr<const void> handle_;
+};
+
+/* 周期发送任务的调度统计（纳秒），延迟为实际发送时刻晚于理论发送时刻的时长 */
+struct PeriodicTaskStats
+{
+    uint64_t period_ns = 0;     // 理论周期（整数部分）
+    uint64_t sends = 0;         // 已发送次数
+    uint64_t missed = 0;        // 调度落后而跳过的周期数
+    uint64_t late_mean_ns = 0;  // 平均延迟
+    uint64_t late_max_ns = 0;   // 最大延迟
+    uint64_t jitter_ns = 0;     // 延迟的标准差
+};
+
+/**
+ * @brief 异步发送的完成回调（普通函数指针，在发送线程内调用，不可阻塞）
+ *  回调内可再次调用 SendAsync；此时即使为 block 策略，在途请求已满也立即返回 -1，不会等待
+ * @param result        0 发送成功，-1 失败（目标无法解析、发送出错或停止时未发出）
+ * @param latency_ns    自提交到发送完成的耗时（纳秒）
+ * @param user_ctx      提交时传入的上下文
+ */
+using SendCompletion = void (*)(int result, uint64_t latency_ns, void *user_ctx);
+
 /**
  * @brief 根据配置文件初始化
  * @param cfgPath   配置文件路径
@@ -65,12 +118,73 @@ int BroadcastMessage(void *pData, size_t size);
  */
 int SendGeneralMessage(const char *addr, int port, void *pData, size_t size);
 
+/**
+ * @brief 异步发送数据，数据拷贝入队后立即返回，完成时调用 callback
+ *  完成记录循环复用，不创建 future；UDP 下由发送线程批量发出，其他协议在调用线程内同步发送后回调
+ * @param addr          发送的目标
+ * @param pData         发送的数据（返回后即可释放）
+ * @param size          发送的数据大小
+ * @param callback      完成回调，可为空（不关心结果）
+ * @param user_ctx      原样传给回调的上下文
+ * @return 0 已提交（callback 必定被调用一次）；-1 在途请求已达 async_send_queue_size（reject 策略，或在完成回调内提交）；
+ *         -2 未初始化或已停止；-3 参数无效（addr 或 pData 为空），重试无意义
+ *         返回非0时 callback 不会被调用
+ */
+int SendAsync(const char *addr, int port, const void *pData, size_t size,
+              SendCompletion callback, void *user_ctx = nullptr);
+
+/**
+ * @brief 发送由多段数据拼接而成的消息（如固定头+变长消息体），无需调用方先拷贝到连续缓冲
+ *  分包按拼接后的整体数据进行，与 SendGeneralMessage 发送连续数据的效果相同
+ * @param addr          发送的目标
+ * @param iov           数据片段数组
+ * @param iovcnt        数据片段数
+ * @return
+ */
+int SendGeneralMessageV(const char *addr, int port, const iovec *iov, int iovcnt);
+
+/**
+ * @brief 发送数据（转移数据所有权，适合大块数据）
+ *  超过 zerocopy_threshold 的数据以零拷贝方式发送，库持有 pData 直至内核不再引用该缓冲，
+ *  调用后不得再修改 pData 指向的内容；其余情况与 SendGeneralMessage 相同
+ *  内核的完成通知在该socket的下一次发送、后台定期回收（约每100毫秒，UDP 使用 io_uring 接收时没有）
+ *  或关闭时才被读取，因此 pData 会在发送完成后仍被持有一段时间
+ * @param addr          发送的目标
+ * @param pData         发送的数据
+ * @param size          发送的数据大小
+ * @return
+ */
+int SendOwnedMessage(const char *addr, int port, std::shared_ptr<const void> pData, size_t size);
+
+/**
+ * @brief 预先解析发送目标（需在 Initialize 之后调用），供频繁发往同一目标时使用
+ * @param addr          发送的目标
+ * @param port          目标端口
+ * @return 解析失败时 valid() 为false
+ */
+Endpoint ResolveEndpoint(const char *addr, int port);
+
+/**
+ * @brief 向预先解析的目标发送数据
+ * @param endpoint      ResolveEndpoint 获得的目标
+ * @param pData         发送的数据
+ * @param size          发送的数据大小
+ * @return
+ */
+int SendTo(const Endpoint &endpoint, void *pData, size_t size);
+
+/**
+ * @brief 向预先解析的目标发送数据（转移数据所有权，同 SendOwnedMessage）
+ * @return
+ */
+int SendTo(const Endpoint &endpoint, std::shared_ptr<const void> pData, size_t size);
+
 /**
  * @brief 添加周期发送任务(更高级周期生成pData，暂不实现)
  * @param addr          发送的目标
  * @param pData         发送的数据
  * @param size          发送的数据大小
- * @param rate          发送的频率（HZ)
+ * @param rate          发送的频率（HZ，1 ~ 100000，按纳秒精度的绝对截止时刻发送，不累积漂移）
  * @param task_id       任务ID(主要用于删除任务)
  *                      -1表示不指定任务ID，系统自动分配
  * @return
@@ -84,6 +198,14 @@ int AddPeriodicSendTask(const char *addr, int port, void *pData, size_t size, in
  */
 int RemovePeriodicSendTask(int task_id);
 
+/**
+ * @brief 获取周期发送任务的调度统计(添加时未指定ID的任务不支持)
+ * @param task_id       任务ID
+ * @param stats         输出的统计
+ * @return
+ */
+int GetPeriodicSendTaskStats(int task_id, PeriodicTaskStats *stats);
+
 /**
  * @brief 订阅消息
  * @param pSubscribe    统一的接收消息的处理函数
@@ -3,6 +3,7 @@
 #include "config_wrapper.h"
 #include "protocol/udp/udp_enhanced.h"
 #include "protocol/tcp/tcp_core.h"
+#include "protocol/kcp/kcp_communicate.h"
 #include "utils/singleton.h"
 
 namespace communicate
@@ -39,6 +40,21 @@ int SocketWrapper::initialize()
         else
             LOG_INFO("TCP communication initialized successfully");
     }
+    else if (protocol == "kcp")
+    {
+#ifdef DUAL_ENDPOINT_MODE
+        LOG_INFO("Creating KCP communication instance");
+        m_communicateImp_ = CommunicateInterface::Create<KcpCommunicate>();
+        ret = m_communicateImp_->initialize();
+        if (ret != 0)
+            LOG_ERROR("Failed to initialize KCP communication, error code: %d", ret);
+        else
+            LOG_INFO("KCP communication initialized successfully");
+#else
+        LOG_ERROR("KCP protocol requires DUAL_ENDPOINT_MODE build");
+        return -1;
+#endif
+    }
     else
     {
         // 其他协议的实现
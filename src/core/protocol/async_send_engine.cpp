@@ -0,0 +1,274 @@
+#include "async_send_engine.h"
+
+#include <chrono>
+#include <list>
+#include <unordered_map>
+
+#include "logger_define.h"
+
+namespace
+{
+// 当前线程所属的引擎（仅发送线程非空），用于识别完成回调内的重入提交
+thread_local const AsyncSendEngine *tls_engine = nullptr;
+} // namespace
+
+AsyncSendEngine::AsyncSendEngine(CommunicateInterface &sender, const Options &options)
+    : sender_(sender),
+      capacity_(roundUp(options.queue_size)),
+      batch_size_(options.batch_size > 0 ? options.batch_size : 1),
+      block_when_full_(options.block_when_full),
+      endpoint_cache_((options.endpoint_cache + threadCount(options) - 1) / threadCount(options)),
+      queue_(capacity_),
+      free_(capacity_)
+{
+    size_t threads = threadCount(options);
+    for (size_t i = 0; i < threads; ++i)
+        threads_.emplace_back(&AsyncSendEngine::run, this);
+    LOG_DEBUG("Async send engine started ({} threads, queue {}, batch {}, {} when full)",
+              threads, capacity_, batch_size_, block_when_full_ ? "block" : "reject");
+}
+
+AsyncSendEngine::~AsyncSendEngine()
+{
+    stop();
+    Request *request = nullptr;
+    while (free_.pop(request))
+        delete request;
+}
+
+size_t AsyncSendEngine::threadCount(const Options &options)
+{
+    return options.threads > 0 ? static_cast<size_t>(options.threads) : 1;
+}
+
+size_t AsyncSendEngine::roundUp(size_t size)
+{
+    size_t capacity = 2;
+    while (capacity < size)
+        capacity <<= 1;
+    return capacity;
+}
+
+uint64_t AsyncSendEngine::nowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+int AsyncSendEngine::submit(const std::string &addr, int port, const void *data, size_t size,
+                            Callback callback, void *ctx)
+{
+    if (stopping_.load(std::memory_order_relaxed))
+        return -2;
+
+    if (!reserveSlot())
+    {
+        if (!block_when_full_ || tls_engine == this)
+            return -1;
+        // 阻塞策略：等待发送线程完成请求释放空位
+        std::unique_lock<std::mutex> lock(space_mutex_);
+        bool reserved = false;
+        waiting_producers_.fetch_add(1);
+        space_cv_.wait(lock, [this, &reserved] { return stopping_.load() || (reserved = reserveSlot()); });
+        waiting_producers_.fetch_sub(1);
+        if (stopping_.load())
+        {
+            // 停止的同时取得了空位：发送线程可能已退出，放弃本次请求
+            if (reserved)
+                in_flight_.fetch_sub(1);
+            return -2;
+        }
+    }
+
+    Request *request = acquire();
+    request->addr = addr;
+    request->port = port;
+    request->data.assign(static_cast<const char *>(data), static_cast<const char *>(data) + size);
+    request->callback = callback;
+    request->ctx = ctx;
+    request->submit_ns = nowNs();
+
+    // 在途请求数不超过队列容量，入队必定成功
+    queue_.push(request);
+    queued_.fetch_add(1);
+    if (sleepers_.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cv_.notify_one();
+    }
+    return 0;
+}
+
+bool AsyncSendEngine::reserveSlot()
+{
+    // 与 release 中"先减在途数、再检查等待者"配对，均使用顺序一致的原子操作，避免漏掉唤醒
+    size_t current = in_flight_.load();
+    do
+    {
+        if (current >= capacity_)
+            return false;
+    } while (!in_flight_.compare_exchange_weak(current, current + 1));
+    return true;
+}
+
+AsyncSendEngine::Request *AsyncSendEngine::acquire()
+{
+    Request *request = nullptr;
+    if (free_.pop(request))
+        return request;
+    return new Request();
+}
+
+void AsyncSendEngine::release(Request *request)
+{
+    if (request->data.capacity() > MAX_RETAINED_CAPACITY)
+        std::vector<char>().swap(request->data);
+    request->callback = nullptr;
+    request->ctx = nullptr;
+    // 请求记录总数不超过容量，归还必定成功
+    if (!free_.push(request))
+        delete request;
+
+    in_flight_.fetch_sub(1);
+    if (waiting_producers_.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(space_mutex_);
+        space_cv_.notify_one();
+    }
+}
+
+void AsyncSendEngine::complete(Request *request, bool ok, uint64_t now)
+{
+    Callback callback = request->callback;
+    void *ctx = request->ctx;
+    uint64_t latency = now - request->submit_ns;
+    // 先归还记录再回调：回调内可立即提交新的请求（发送线程内的提交不会阻塞，见 submit）
+    release(request);
+    if (callback)
+        callback(ok ? 0 : -1, latency, ctx);
+}
+
+void AsyncSendEngine::stop()
+{
+    if (stopping_.exchange(true))
+        return;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cv_.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(space_mutex_);
+        space_cv_.notify_all();
+    }
+    for (auto &thread : threads_)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    // 停止的同时入队的请求：发送线程已退出，直接以失败完成
+    Request *request = nullptr;
+    while (queue_.pop(request))
+    {
+        queued_.fetch_sub(1);
+        complete(request, false, nowNs());
+    }
+    LOG_DEBUG("Async send engine stopped");
+}
+
+void AsyncSendEngine::run()
+{
+    std::vector<Request *> batch;
+    std::vector<Request *> sending;
+    std::vector<CommunicateInterface::OutgoingMessage> messages;
+    std::vector<bool> results;
+    // 本线程的预解析目标缓存，"addr:port" -> 句柄（lru 队首为最近使用）
+    // 不在 send_list 中的目标的句柄各自持有一个socket，因此缓存须有上限
+    using EndpointPtr = std::shared_ptr<const CommunicateInterface::EndpointHandle>;
+    struct CachedEndpoint
+    {
+        EndpointPtr endpoint;
+        std::list<std::string>::iterator lru;
+    };
+    std::unordered_map<std::string, CachedEndpoint> endpoints;
+    std::list<std::string> lru;
+    std::vector<EndpointPtr> retired;       // 本批次内被淘汰（或未缓存）的句柄，发送完成后释放
+    std::string key;
+    batch.reserve(batch_size_);
+    tls_engine = this;
+
+    for (;;)
+    {
+        batch.clear();
+        Request *request = nullptr;
+        while (batch.size() < batch_size_ && queue_.pop(request))
+            batch.push_back(request);
+
+        if (batch.empty())
+        {
+            if (stopping_.load())
+                break;
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            sleepers_.fetch_add(1);
+            wake_cv_.wait(lock, [this] { return queued_.load() > 0 || stopping_.load(); });
+            sleepers_.fetch_sub(1);
+            continue;
+        }
+        queued_.fetch_sub(batch.size());
+
+        sending.clear();
+        messages.clear();
+        for (Request *req : batch)
+        {
+            key.assign(req->addr).append(":").append(std::to_string(req->port));
+            const CommunicateInterface::EndpointHandle *handle = nullptr;
+            auto it = endpoints.find(key);
+            if (it != endpoints.end())
+            {
+                lru.splice(lru.begin(), lru, it->second.lru);
+                handle = it->second.endpoint.get();
+            }
+            else
+            {
+                auto endpoint = sender_.resolveEndpoint(req->addr, req->port);
+                if (!endpoint)
+                {
+                    LOG_ERROR("Async send to {}:{} failed: cannot resolve destination", req->addr, req->port);
+                    complete(req, false, nowNs());
+                    continue;
+                }
+                handle = endpoint.get();
+                if (endpoint_cache_ == 0)
+                {
+                    retired.push_back(std::move(endpoint));
+                }
+                else
+                {
+                    // 超出容量时淘汰最久未使用的一个，本批次内仍可能引用它，待发送完成后再释放
+                    if (endpoints.size() >= endpoint_cache_)
+                    {
+                        auto victim = endpoints.find(lru.back());
+                        retired.push_back(std::move(victim->second.endpoint));
+                        endpoints.erase(victim);
+                        lru.pop_back();
+                    }
+                    lru.push_front(key);
+                    endpoints.emplace(key, CachedEndpoint{std::move(endpoint), lru.begin()});
+                }
+            }
+            sending.push_back(req);
+            messages.push_back({handle, req->data.data(), req->data.size()});
+        }
+        if (messages.empty())
+        {
+            retired.clear();
+            continue;
+        }
+
+        sender_.sendBurst(messages, &results);
+        retired.clear();
+        uint64_t now = nowNs();
+        for (size_t i = 0; i < sending.size(); ++i)
+            complete(sending[i], results[i], now);
+    }
+}
@@ -0,0 +1,119 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        async_send_engine.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 异步发送引擎（每个传输实例一个）
+    1. 调用方把数据拷入请求记录后压入无锁有界队列即返回；请求记录循环复用，数据缓冲的容量随之保留
+    2. 固定数量的发送线程批量取出请求，目标地址经线程内缓存（LRU）的预解析句柄，一批请求由 sendBurst 一并发出，
+       完成后在发送线程内回调调用方（结果及入队到发送完成的耗时）；回调为普通函数指针加上下文，请求记录即完成记录，无额外分配
+    3. 在途请求数以队列容量为上限：超出时按配置立即失败（reject）或阻塞等待空位（block），不再无限制地创建线程
+    4. 发送线程空闲时休眠，只有存在休眠线程时生产者才需要加锁唤醒
+    5. 停止时先发完已入队的请求
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef ASYNC_SEND_ENGINE_H_
+#define ASYNC_SEND_ENGINE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "communicate_interface.h"
+#include "utils/bounded_queue.h"
+
+class AsyncSendEngine
+{
+public:
+    // 发送完成回调（result 0 成功 / -1 失败），在发送线程内调用，不可阻塞
+    using Callback = communicate::SendCompletion;
+
+    struct Options
+    {
+        size_t queue_size = 16384;      // 在途请求上限（向上取整为2的幂）
+        int threads = 1;                // 发送线程数
+        size_t batch_size = 64;         // 每次最多取出并一并发送的请求数
+        bool block_when_full = false;   // 在途请求达到上限时阻塞等待，否则立即失败
+        size_t endpoint_cache = 64;     // 预解析目标的缓存上限（各发送线程均分，LRU淘汰），0 为每批重新解析
+    };
+
+    // 请求经 sender 的 sendBurst 发出，sender 须比引擎存活更久
+    AsyncSendEngine(CommunicateInterface &sender, const Options &options);
+    ~AsyncSendEngine();
+
+    AsyncSendEngine(const AsyncSendEngine &) = delete;
+    AsyncSendEngine &operator=(const AsyncSendEngine &) = delete;
+
+    /**
+     * @brief 拷贝数据并入队，返回后调用方即可释放 data；入队成功时 callback 必定被调用一次
+     *        发送线程内（完成回调中）提交时不阻塞：等待空位需要发送线程自身完成请求，可能永远等不到
+     * @return 0 成功；-1 在途请求已达上限（reject 策略，或在发送线程内提交）；-2 引擎已停止
+     */
+    int submit(const std::string &addr, int port, const void *data, size_t size, Callback callback, void *ctx);
+
+    // 当前在途（已入队未完成）的请求数
+    size_t inFlight() const { return in_flight_.load(std::memory_order_relaxed); }
+
+    // 发完已入队的请求后停止发送线程（析构时自动调用）
+    void stop();
+
+private:
+    struct Request
+    {
+        std::string addr;
+        int port = 0;
+        std::vector<char> data;     // 复用时保留容量
+        Callback callback = nullptr;
+        void *ctx = nullptr;
+        uint64_t submit_ns = 0;
+    };
+
+    // 超过该容量的数据缓冲在归还请求记录时释放，避免偶发的大消息长期占用内存
+    static constexpr size_t MAX_RETAINED_CAPACITY = 65536;
+
+    bool reserveSlot();
+    Request *acquire();
+    void release(Request *request);
+    void complete(Request *request, bool ok, uint64_t now);
+    void run();
+    static uint64_t nowNs();
+    static size_t roundUp(size_t size);
+    static size_t threadCount(const Options &options);
+
+    CommunicateInterface &sender_;
+    const size_t capacity_;
+    const size_t batch_size_;
+    const bool block_when_full_;
+    const size_t endpoint_cache_;           // 每个发送线程的预解析目标上限
+
+    BoundedQueue<Request *> queue_;         // 待发送的请求
+    BoundedQueue<Request *> free_;          // 空闲的请求记录
+    std::atomic<size_t> in_flight_{0};      // 已占用的请求数（含未取出与发送中）
+    std::atomic<size_t> queued_{0};         // 队列中尚未取出的请求数
+    std::atomic<bool> stopping_{false};
+
+    // 发送线程休眠与唤醒
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<int> sleepers_{0};
+
+    // 阻塞策略下等待空位的生产者
+    std::mutex space_mutex_;
+    std::condition_variable space_cv_;
+    std::atomic<int> waiting_producers_{0};
+
+    std::vector<std::thread> threads_;
+};
+
+#endif // ASYNC_SEND_ENGINE_H_
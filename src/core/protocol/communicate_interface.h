@@ -15,11 +15,14 @@ Version history
 #ifndef COMMUNICATE_INTERFACE_H
 #define COMMUNICATE_INTERFACE_H
 
+#include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "communicate_api.h"
 
@@ -41,12 +44,102 @@ public:
     virtual void shutdown() = 0;
 
     /* **** 高级功能接口（可选实现） **** */
+    // 预解析的发送目标，派生类继承后保存解析结果（地址结构、发送socket等）
+    struct EndpointHandle
+    {
+        virtual ~EndpointHandle() = default;
+        std::string addr;
+        int port = 0;
+    };
+    // 解析发送目标，失败返回空；默认实现只保存地址，发送时仍走 send
+    virtual std::shared_ptr<const EndpointHandle> resolveEndpoint(const std::string &addr, int port)
+    {
+        auto endpoint = std::make_shared<EndpointHandle>();
+        endpoint->addr = addr;
+        endpoint->port = port;
+        return endpoint;
+    }
+    virtual bool sendTo(const EndpointHandle &endpoint, const void *data, size_t size)
+    {
+        return send(endpoint.addr, endpoint.port, data, size);
+    }
+    virtual bool sendOwnedTo(const EndpointHandle &endpoint, std::shared_ptr<const void> data, size_t size)
+    {
+        return sendOwned(endpoint.addr, endpoint.port, std::move(data), size);
+    }
+    // 同一份数据发往多个目标，results 按 dest_list 顺序记录各目标是否发送成功，返回失败的目标数
+    virtual int sendBatch(const std::vector<std::pair<std::string, int>> &dest_list,
+                          const void *data, size_t size, std::vector<bool> *results = nullptr)
+    {
+        int failed = 0;
+        if (results)
+            results->assign(dest_list.size(), false);
+        for (size_t i = 0; i < dest_list.size(); ++i)
+        {
+            bool ok = send(dest_list[i].first, dest_list[i].second, data, size);
+            if (results)
+                (*results)[i] = ok;
+            failed += ok ? 0 : 1;
+        }
+        return failed;
+    }
+    // 目标与数据各不相同的多条消息（如同一时刻到期的周期任务）一并发出
+    struct OutgoingMessage
+    {
+        const EndpointHandle *endpoint = nullptr;
+        const void *data = nullptr;
+        size_t size = 0;
+    };
+    // results 按 messages 顺序记录各消息是否发送成功，返回失败的消息数；默认实现逐条 sendTo
+    virtual int sendBurst(const std::vector<OutgoingMessage> &messages, std::vector<bool> *results = nullptr)
+    {
+        int failed = 0;
+        if (results)
+            results->assign(messages.size(), false);
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            bool ok = sendTo(*messages[i].endpoint, messages[i].data, messages[i].size);
+            if (results)
+                (*results)[i] = ok;
+            failed += ok ? 0 : 1;
+        }
+        return failed;
+    }
+    // 多段数据拼接为一条消息发送，默认实现拷贝到连续缓冲后调用 send
+    virtual bool sendv(const std::string &dest_addr, int dest_port, const communicate::iovec *iov, int iovcnt)
+    {
+        std::vector<char> buffer;
+        for (int i = 0; i < iovcnt; ++i)
+        {
+            const char *base = static_cast<const char *>(iov[i].iov_base);
+            buffer.insert(buffer.end(), base, base + iov[i].iov_len);
+        }
+        return send(dest_addr, dest_port, buffer.data(), buffer.size());
+    }
+    // 转移数据所有权的发送：实现可持有 data 直至内核不再引用（零拷贝），调用方不得再修改其内容
+    virtual bool sendOwned(const std::string &dest_addr, int dest_port, std::shared_ptr<const void> data, size_t size)
+    {
+        return send(dest_addr, dest_port, data.get(), size);
+    }
     virtual std::future<bool> sendAsync(const std::string &dest_addr, int dest_port, const void *data, size_t size)
     {
         return std::async(std::launch::async, [this, dest_addr, dest_port, data, size]() {
             return this->send(dest_addr, dest_port, data, size);
         });
     }
+    // 完成回调式的异步发送，返回0时 callback 必定被调用一次；默认实现在调用线程内同步发送后回调
+    virtual int sendAsync(const std::string &dest_addr, int dest_port, const void *data, size_t size,
+                          communicate::SendCompletion callback, void *ctx)
+    {
+        auto start = std::chrono::steady_clock::now();
+        bool ok = send(dest_addr, dest_port, data, size);
+        if (callback)
+        {
+            auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            callback(ok ? 0 : -1, static_cast<uint64_t>(latency.count()), ctx);
+        }
+        return 0;
+    }
     // 周期发送固定数据
     virtual int addPeriodicSendTask(const char *addr, int port, const void *pData, size_t size, int rate, int task_id = -1)
     {
@@ -56,6 +149,10 @@ public:
     {
         return -1; // 默认不支持
     }
+    virtual int periodicTaskStats(int task_id, communicate::PeriodicTaskStats &stats)
+    {
+        return -1; // 默认不支持
+    }
     virtual void setDefSource(int port, std::string source_ip = "")
     {
         // 默认实现不设置发送端口和网卡
@@ -0,0 +1,157 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        kcp_allocator.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 经 ikcp_allocator 接入KCP的分级内存池（需DUAL_ENDPOINT_MODE编译）
+    1. KCP的分配集中在少数几种尺寸：段（段头+不超过mss的数据）、控制块、(mtu+24)*3 的输出缓冲与ACK列表，
+       收发每个分片都要分配、释放一次段
+    2. 按尺寸分级：64 字节起，每个2的幂区间再均分四级（浪费不超过25%），直到 8KB；更大的直接走 malloc
+    3. 每级一个空闲链表与一把锁，释放的块缓存复用，每级缓存上限 MAX_CACHED_BYTES
+    4. 块前16字节记录所属级别，释放时据此归还；内存池进程内唯一且不析构，保证KCP对象释放时仍然可用
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef KCP_ALLOCATOR_H_
+#define KCP_ALLOCATOR_H_
+
+#ifdef DUAL_ENDPOINT_MODE
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+
+#include "utils/kcp/ikcp.h"
+
+class KcpAllocator
+{
+public:
+    // 把内存池注册为KCP的分配器（进程内只生效一次，须在创建首个KCP对象前调用）
+    static void install()
+    {
+        static std::once_flag once;
+        std::call_once(once, [] { ikcp_allocator(&KcpAllocator::allocate, &KcpAllocator::release); });
+    }
+
+    static void *allocate(size_t size)
+    {
+        size_t total = size + HEADER_SIZE;
+        if (total > MAX_CLASS_SIZE)
+            return attach(std::malloc(total), LARGE_CLASS);
+
+        uint32_t index = classIndex(total);
+        FreeList &list = instance().lists_[index];
+        {
+            std::lock_guard<std::mutex> lock(list.mutex);
+            if (list.head)
+            {
+                Block *block = list.head;
+                list.head = block->next;
+                --list.count;
+                return attach(block, index);
+            }
+        }
+        return attach(std::malloc(classSize(index)), index);
+    }
+
+    static void release(void *ptr)
+    {
+        if (!ptr)
+            return;
+        void *raw = static_cast<char *>(ptr) - HEADER_SIZE;
+        uint32_t index = *static_cast<uint32_t *>(raw);
+        if (index == LARGE_CLASS)
+        {
+            std::free(raw);
+            return;
+        }
+
+        FreeList &list = instance().lists_[index];
+        {
+            std::lock_guard<std::mutex> lock(list.mutex);
+            if (list.count * classSize(index) < MAX_CACHED_BYTES)
+            {
+                Block *block = static_cast<Block *>(raw);
+                block->next = list.head;
+                list.head = block;
+                ++list.count;
+                return;
+            }
+        }
+        std::free(raw);
+    }
+
+private:
+    static constexpr size_t HEADER_SIZE = 16;               // 保持返回地址16字节对齐
+    static constexpr size_t MIN_CLASS_SIZE = 64;
+    static constexpr size_t MAX_CLASS_SIZE = 8192;
+    static constexpr uint32_t CLASS_COUNT = 29;             // 64，以及 2^6 ~ 2^13 每个区间四级
+    static constexpr uint32_t LARGE_CLASS = UINT32_MAX;
+    static constexpr size_t MAX_CACHED_BYTES = 4 * 1024 * 1024;
+
+    struct Block
+    {
+        Block *next;
+    };
+
+    struct FreeList
+    {
+        std::mutex mutex;
+        Block *head = nullptr;
+        size_t count = 0;
+    };
+
+    static KcpAllocator &instance()
+    {
+        // 有意不释放：静态析构之后仍可能有KCP对象归还内存
+        static KcpAllocator *pool = new KcpAllocator();
+        return *pool;
+    }
+
+    static uint32_t highestBit(size_t value)
+    {
+        uint32_t bit = 0;
+        while (value >>= 1)
+            ++bit;
+        return bit;
+    }
+
+    // 尺寸 -> 级别：(2^b, 2^(b+1)] 区间按 2^(b-2) 步长分为四级
+    static uint32_t classIndex(size_t size)
+    {
+        if (size <= MIN_CLASS_SIZE)
+            return 0;
+        uint32_t bit = highestBit(size - 1);
+        uint32_t step = static_cast<uint32_t>((size - 1) >> (bit - 2)) - 3;   // 1 ~ 4
+        return 1 + (bit - 6) * 4 + (step - 1);
+    }
+
+    static size_t classSize(uint32_t index)
+    {
+        if (index == 0)
+            return MIN_CLASS_SIZE;
+        uint32_t bit = 6 + (index - 1) / 4;
+        uint32_t step = (index - 1) % 4 + 1;
+        return (size_t(1) << bit) + (size_t(step) << (bit - 2));
+    }
+
+    static void *attach(void *raw, uint32_t index)
+    {
+        if (!raw)
+            return nullptr;
+        *static_cast<uint32_t *>(raw) = index;
+        return static_cast<char *>(raw) + HEADER_SIZE;
+    }
+
+    FreeList lists_[CLASS_COUNT];
+};
+
+#endif // DUAL_ENDPOINT_MODE
+
+#endif // KCP_ALLOCATOR_H_
@@ -0,0 +1,550 @@
+#include "kcp_communicate.h"
+
+#ifdef DUAL_ENDPOINT_MODE
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <random>
+
+#include "kcp_allocator.h"
+#include "utils/flat_hash_map.h"
+#include "utils/kcp/ikcp.h"
+#include "utils/timer_wheel.h"
+
+class KcpCommunicate::Impl
+{
+public:
+    Impl(KcpCommunicate &owner, KcpConfig &config) : owner_(owner), config_(config)
+    {
+        // 须在创建首个KCP对象前注册
+        KcpAllocator::install();
+        // conv 起始值随机，避免重启后与对端残留的会话冲突
+        std::random_device rd;
+        next_conv_.store(rd());
+    }
+
+    ~Impl()
+    {
+        stop();
+    }
+
+    void start()
+    {
+        if (!is_running_.exchange(true))
+        {
+            update_thread_ = std::thread(&Impl::updateLoop, this);
+        }
+    }
+
+    void stop()
+    {
+        if (is_running_.exchange(false))
+        {
+            {
+                std::lock_guard<std::mutex> lock(wheel_mutex_);
+            }
+            wheel_cv_.notify_all();
+            if (update_thread_.joinable())
+                update_thread_.join();
+        }
+    }
+
+    bool send(const std::string &dest_addr, int dest_port, const void *data, size_t size)
+    {
+        sockaddr_in peer = {};
+        peer.sin_family = AF_INET;
+        peer.sin_port = htons(static_cast<uint16_t>(dest_port));
+        if (inet_pton(AF_INET, dest_addr.c_str(), &peer.sin_addr) != 1)
+        {
+            LOG_ERROR("Invalid destination address: {}", dest_addr);
+            return false;
+        }
+
+        SessionPtr session = peerSession(SubscriberRouter::endpointKey(peer));
+        if (!session)
+            return false;
+
+        std::lock_guard<std::mutex> lock(session->mutex);
+        uint64_t now = nowMs();
+        // 挂起的会话可能很久未更新，先刷新KCP时钟，保证时间戳与重传计时准确
+        ikcp_update(session->kcp, static_cast<uint32_t>(now));
+        bool queued = ikcp_send(session->kcp, static_cast<const char *>(data), static_cast<int>(size)) >= 0;
+        if (queued)
+        {
+            // 立即发出窗口内的数据，不等待下一次 update
+            ikcp_flush(session->kcp);
+            session->last_active = now;
+            LOG_TRACE("Queued {} bytes to {}:{} on conv {}", size, dest_addr, dest_port, session->conv);
+        }
+        else
+        {
+            LOG_ERROR("KCP send of {} bytes to {}:{} failed (message too large for receive window)",
+                      size, dest_addr, dest_port);
+        }
+        reschedule(*session, session, now);
+        return queued;
+    }
+
+    // 监听socket收到的数据报（接收线程内调用）
+    void onDatagram(communicate::SubscribebBase *sub, uint64_t src_key, uint64_t local_key,
+                    const std::shared_ptr<void> &data, size_t len)
+    {
+        if (len < KCP_OVERHEAD)
+        {
+            LOG_DEBUG("Dropped {} byte datagram too short for KCP", len);
+            return;
+        }
+        const char *buf = static_cast<const char *>(data.get());
+        uint32_t conv = ikcp_getconv(buf);
+
+        SessionPtr session = findSession(src_key, conv);
+        bool accepted = false;
+        if (!session)
+        {
+            // 未知会话只接受段头合法的数据报，避免杂散/伪造流量建立会话
+            if (!plausibleSegment(buf, len))
+            {
+                LOG_DEBUG("Dropped {} byte datagram with invalid KCP header from peer {:x}", len, src_key);
+                return;
+            }
+            session = acceptSession(src_key, conv, static_cast<uint16_t>(local_key & 0xFFFF), accepted);
+            if (!session)
+                return;
+        }
+
+        std::vector<std::shared_ptr<void>> messages;
+        bool drop = false;
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            uint64_t now = nowMs();
+            ikcp_update(session->kcp, static_cast<uint32_t>(now));
+            if (ikcp_input(session->kcp, buf, static_cast<long>(len)) < 0)
+            {
+                LOG_DEBUG("Invalid KCP segment on conv {}", conv);
+                // 由本数据报新建的会话不保留，避免占用会话表与对端的发送会话直到空闲超时
+                drop = accepted;
+            }
+            else
+            {
+                session->last_active = now;
+
+                int size;
+                while ((size = ikcp_peeksize(session->kcp)) > 0)
+                {
+                    std::shared_ptr<char> message(new char[size], std::default_delete<char[]>());
+                    ikcp_recv(session->kcp, message.get(), size);
+                    messages.push_back(std::move(message));
+                }
+                // 及时回复ACK（及窗口内待发数据），降低对端的重传等待
+                ikcp_flush(session->kcp);
+            }
+            if (drop)
+                session->closed = true;
+            else
+                reschedule(*session, session, now);
+        }
+        if (drop)
+        {
+            removeSession(session);
+            return;
+        }
+
+        if (messages.empty())
+            return;
+        if (!sub)
+        {
+            LOG_WARNING("No subscriber found for message");
+            return;
+        }
+
+        auto process_msgs = [sub, messages = std::move(messages)] {
+            for (const auto &msg_data : messages)
+            {
+                sub->handleMsg(msg_data);
+            }
+        };
+#ifdef THREAD_POOL_MODE
+        KcpCommunicate::s_thread_pool_->enqueue(process_msgs);
+#else
+        process_msgs();
+#endif
+    }
+
+private:
+    static constexpr size_t KCP_OVERHEAD = 24;  // KCP段头长度（同 ikcp.c 中的 IKCP_OVERHEAD）
+    static constexpr uint8_t KCP_CMD_PUSH = 81; // 段命令字范围（同 ikcp.c 中的 IKCP_CMD_PUSH..IKCP_CMD_WINS）
+    static constexpr uint8_t KCP_CMD_WINS = 84;
+
+    struct Session
+    {
+        std::mutex mutex;                   // 保护以下可变成员
+        ikcpcb *kcp = nullptr;
+        uint32_t conv = 0;
+        uint64_t peer_key = 0;
+        sockaddr_in peer = {};
+        SocketType fd = INVALID_SOCKET;     // 发出数据报使用的监听socket
+        uint64_t last_active = 0;           // 最近一次收发的时刻(毫秒)
+        uint64_t scheduled = 0;             // 时间轮中有效条目的到期时刻，0 为未登记；其余条目取出时忽略
+        bool closed = false;                // 已从会话表移除
+
+        ~Session()
+        {
+            if (kcp)
+                ikcp_release(kcp);
+        }
+    };
+    using SessionPtr = std::shared_ptr<Session>;
+
+    struct SessionKey
+    {
+        uint64_t peer;
+        uint32_t conv;
+        bool operator==(const SessionKey &other) const { return peer == other.peer && conv == other.conv; }
+    };
+
+    struct SessionKeyHash
+    {
+        size_t operator()(const SessionKey &key) const
+        {
+            return static_cast<size_t>(key.peer * 0x9E3779B97F4A7C15ULL ^ key.conv);
+        }
+    };
+
+    // 毫秒时间戳，低32位即KCP使用的时钟
+    static uint64_t nowMs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static int output(const char *buf, int len, ikcpcb *, void *user)
+    {
+        auto *session = static_cast<Session *>(user);
+        ssize_t sent = sendto(session->fd, buf, len, 0,
+                              reinterpret_cast<const sockaddr *>(&session->peer), sizeof(session->peer));
+        if (sent != len)
+            LOG_DEBUG("KCP output on conv {} failed: {}", session->conv, strerror(errno));
+        return 0;
+    }
+
+    // 未知会话的首个数据报：首段命令字须为 KCP 定义的类型，且声明的数据长度不超出数据报
+    static bool plausibleSegment(const char *buf, size_t len)
+    {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(buf);
+        uint8_t cmd = bytes[4];
+        if (cmd < KCP_CMD_PUSH || cmd > KCP_CMD_WINS)
+            return false;
+        // 段头字段按小端编码（同 ikcp_decode32u）
+        uint32_t seg_len = static_cast<uint32_t>(bytes[20]) | static_cast<uint32_t>(bytes[21]) << 8 |
+                           static_cast<uint32_t>(bytes[22]) << 16 | static_cast<uint32_t>(bytes[23]) << 24;
+        return seg_len <= len - KCP_OVERHEAD;
+    }
+
+    // 没有待发送、待确认的数据，也没有待回复的ACK与窗口探测：在有新的收发之前无需 update
+    static bool quiescent(const ikcpcb *kcp)
+    {
+        return ikcp_waitsnd(kcp) == 0 && kcp->ackcount == 0 && kcp->probe == 0;
+    }
+
+    /**
+     * @brief 按会话当前状态登记下一次更新（调用方持有 session.mutex）
+     *        活跃会话按 ikcp_check 的结果登记；静止的会话只在空闲超时的时刻检查一次
+     */
+    void reschedule(Session &session, const SessionPtr &ptr, uint64_t now)
+    {
+        uint64_t due;
+        if (quiescent(session.kcp))
+        {
+            if (config_.session_timeout_ms <= 0)
+                return;
+            due = session.last_active + static_cast<uint64_t>(config_.session_timeout_ms);
+        }
+        else
+        {
+            uint32_t current = static_cast<uint32_t>(now);
+            due = now + static_cast<uint32_t>(ikcp_check(session.kcp, current) - current);
+        }
+        // 已登记的条目不晚于 due 时沿用，到期时会重新计算
+        if (session.scheduled != 0 && session.scheduled <= due)
+            return;
+
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(wheel_mutex_);
+            // 已过期的时刻按时间轮的当前tick登记，记录实际值以便到期时比对
+            session.scheduled = wheel_.schedule(due, ptr);
+            wake = session.scheduled < wake_at_;
+        }
+        if (wake)
+            wheel_cv_.notify_one();
+    }
+
+    SessionPtr findSession(uint64_t peer_key, uint32_t conv)
+    {
+        std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
+        const SessionPtr *session = sessions_.find(SessionKey{peer_key, conv});
+        return session ? *session : nullptr;
+    }
+
+    SessionPtr createSession(uint64_t peer_key, uint32_t conv, SocketType fd)
+    {
+        auto session = std::make_shared<Session>();
+        session->conv = conv;
+        session->peer_key = peer_key;
+        session->peer.sin_family = AF_INET;
+        session->peer.sin_addr.s_addr = htonl(static_cast<uint32_t>(peer_key >> 16));
+        session->peer.sin_port = htons(static_cast<uint16_t>(peer_key & 0xFFFF));
+        session->fd = fd;
+        session->last_active = nowMs();
+
+        session->kcp = ikcp_create(conv, session.get());
+        ikcp_setoutput(session->kcp, &Impl::output);
+        ikcp_nodelay(session->kcp, config_.nodelay, config_.interval, config_.resend, config_.nc);
+        ikcp_wndsize(session->kcp, config_.snd_wnd, config_.rcv_wnd);
+        ikcp_setmtu(session->kcp, config_.mtu);
+        // 首次 update 之后 flush 才会发出数据；随后由创建者的首次收发登记调度
+        ikcp_update(session->kcp, static_cast<uint32_t>(session->last_active));
+        return session;
+    }
+
+    // 发往 peer_key 使用的会话：优先沿用已有会话（含对端发起的），否则以新分配的conv建立
+    SessionPtr peerSession(uint64_t peer_key)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
+            const SessionPtr *session = peers_.find(peer_key);
+            if (session)
+                return *session;
+        }
+
+        SocketType fd = owner_.listenSocket();
+        if (fd == INVALID_SOCKET)
+        {
+            LOG_ERROR("KCP requires at least one listen address to send from");
+            return nullptr;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+        const SessionPtr *existing = peers_.find(peer_key);
+        if (existing)
+            return *existing;
+
+        uint32_t conv;
+        do
+        {
+            conv = next_conv_.fetch_add(1);
+        } while (conv == 0 || sessions_.find(SessionKey{peer_key, conv}));
+        SessionPtr session = createSession(peer_key, conv, fd);
+        sessions_.emplace(SessionKey{peer_key, conv}, session);
+        peers_.emplace(peer_key, session);
+        LOG_DEBUG("Opened KCP conv {} to peer {:x}", conv, peer_key);
+        return session;
+    }
+
+    // 对端发起的会话：回复经收到数据的监听端口发出，created 返回是否由本次调用新建
+    SessionPtr acceptSession(uint64_t peer_key, uint32_t conv, uint16_t local_port, bool &created)
+    {
+        SocketType fd = owner_.listenSocket(local_port);
+        if (fd == INVALID_SOCKET)
+            return nullptr;
+
+        std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+        SessionPtr &session = sessions_[SessionKey{peer_key, conv}];
+        if (!session)
+        {
+            session = createSession(peer_key, conv, fd);
+            peers_.emplace(peer_key, session);
+            created = true;
+            LOG_DEBUG("Accepted KCP conv {} from peer {:x}", conv, peer_key);
+        }
+        return session;
+    }
+
+    void removeSession(const SessionPtr &session)
+    {
+        std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+        sessions_.erase(SessionKey{session->peer_key, session->conv});
+        const SessionPtr *peer = peers_.find(session->peer_key);
+        if (peer && *peer == session)
+            peers_.erase(session->peer_key);
+    }
+
+    // 处理到期的时间轮条目：驱动重传、窗口探测与ACK发送，释放失效或空闲的会话
+    void updateSession(const SessionPtr &session, uint64_t expire)
+    {
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            if (session->closed || session->scheduled != expire)
+                return;
+            session->scheduled = 0;
+
+            uint64_t now = nowMs();
+            ikcp_update(session->kcp, static_cast<uint32_t>(now));
+            // state 为 -1 表示某个分片重传次数超过 dead_link
+            bool dead = session->kcp->state == static_cast<IUINT32>(-1);
+            bool idle = config_.session_timeout_ms > 0 && quiescent(session->kcp) &&
+                        now - session->last_active >= static_cast<uint64_t>(config_.session_timeout_ms);
+            if (dead)
+                LOG_WARNING("KCP conv {} link dead, closing session", session->conv);
+            else if (idle)
+                LOG_DEBUG("KCP conv {} idle, closing session", session->conv);
+            if (!dead && !idle)
+            {
+                reschedule(*session, session, now);
+                return;
+            }
+            session->closed = true;
+        }
+        removeSession(session);
+    }
+
+    // 只处理时间轮中到期的会话；全部会话静止时一直休眠，直到有新的收发登记
+    void updateLoop()
+    {
+        LOG_INFO("KCP update thread started");
+        std::vector<std::pair<uint64_t, SessionPtr>> due;
+
+        std::unique_lock<std::mutex> lock(wheel_mutex_);
+        while (is_running_.load())
+        {
+            uint64_t now = nowMs();
+            wheel_.advance(now, [&due](uint64_t expire, SessionPtr &session) {
+                due.emplace_back(expire, std::move(session));
+            });
+            if (!due.empty())
+            {
+                lock.unlock();
+                for (const auto &item : due)
+                    updateSession(item.second, item.first);
+                due.clear();
+                lock.lock();
+                continue;
+            }
+
+            wake_at_ = wheel_.nextExpiry();
+            if (wake_at_ == UINT64_MAX)
+                wheel_cv_.wait(lock);
+            else
+                wheel_cv_.wait_for(lock, std::chrono::milliseconds(wake_at_ - now));
+            wake_at_ = 0;
+        }
+        LOG_INFO("KCP update thread exiting");
+    }
+
+    KcpCommunicate &owner_;
+    KcpConfig &config_;
+
+    std::shared_mutex sessions_mutex_;
+    FlatHashMap<SessionKey, SessionPtr, SessionKeyHash> sessions_;   // (对端, conv) -> 会话，收到的段按此分发
+    FlatHashMap<uint64_t, SessionPtr> peers_;                        // 对端 -> 发送使用的会话
+    std::atomic<uint32_t> next_conv_{1};
+
+    std::mutex wheel_mutex_;                        // 保护时间轮与 wake_at_
+    std::condition_variable wheel_cv_;
+    TimerWheel<SessionPtr> wheel_{nowMs()};         // 按毫秒登记各会话的下一次更新
+    uint64_t wake_at_ = 0;                          // 更新线程休眠至该时刻，0 表示正在处理
+    std::atomic<bool> is_running_{false};
+    std::thread update_thread_;
+};
+
+KcpCommunicate::KcpCommunicate() : pimpl_(std::make_unique<Impl>(*this, m_kcp_config))
+{
+    LOG_TRACE("KcpCommunicate constructor");
+}
+
+KcpCommunicate::~KcpCommunicate()
+{
+    LOG_TRACE("KcpCommunicate destructor");
+    // 先停止接收线程，数据报处理引用了本对象的会话表
+    shutdown();
+}
+
+int KcpCommunicate::initialize()
+{
+    LOG_INFO("Initializing KCP communication");
+
+    int ret = UdpCommunicateCore::initialize();
+    if (ret != 0)
+        return ret;
+
+    auto &cfg = SingletonTemplate<ConfigWrapper>::getSingletonInstance().getCfgInstance();
+    m_kcp_config.nodelay = cfg.getValue("kcp_nodelay", 1);
+    m_kcp_config.interval = cfg.getValue("kcp_interval", 10);
+    m_kcp_config.resend = cfg.getValue("kcp_resend", 2);
+    m_kcp_config.nc = cfg.getValue("kcp_nc", 1);
+    m_kcp_config.snd_wnd = cfg.getValue("kcp_snd_wnd", 128);
+    m_kcp_config.rcv_wnd = cfg.getValue("kcp_rcv_wnd", 128);
+    m_kcp_config.mtu = cfg.getValue("kcp_mtu", 1400);
+    m_kcp_config.session_timeout_ms = cfg.getValue("kcp_session_timeout_ms", 60000);
+
+    LOG_DEBUG("KCP configuration - nodelay: {}, interval: {}ms, resend: {}, nc: {}, wnd: {}/{}, mtu: {}",
+              m_kcp_config.nodelay, m_kcp_config.interval, m_kcp_config.resend, m_kcp_config.nc,
+              m_kcp_config.snd_wnd, m_kcp_config.rcv_wnd, m_kcp_config.mtu);
+
+    if (listenSocket() == INVALID_SOCKET)
+        LOG_WARNING("No listen address configured, KCP cannot send or receive until one is added");
+
+    setDatagramHandler([this](communicate::SubscribebBase *sub, uint64_t src_key, uint64_t local_key,
+                              const std::shared_ptr<void> &data, size_t len) {
+        pimpl_->onDatagram(sub, src_key, local_key, data, len);
+    });
+    pimpl_->start();
+    // 对端的ACK同样经监听socket到达，未订阅时也须接收
+    startReceiving();
+
+    LOG_INFO("KCP communication initialized successfully");
+    return 0;
+}
+
+bool KcpCommunicate::send(const std::string &dest_addr, int dest_port, const void *data, size_t size)
+{
+    return pimpl_->send(dest_addr, dest_port, data, size);
+}
+
+bool KcpCommunicate::sendv(const std::string &dest_addr, int dest_port, const communicate::iovec *iov, int iovcnt)
+{
+    return CommunicateInterface::sendv(dest_addr, dest_port, iov, iovcnt);
+}
+
+bool KcpCommunicate::sendOwned(const std::string &dest_addr, int dest_port, std::shared_ptr<const void> data,
+                               size_t size)
+{
+    return CommunicateInterface::sendOwned(dest_addr, dest_port, std::move(data), size);
+}
+
+int KcpCommunicate::sendBatch(const std::vector<std::pair<std::string, int>> &dest_list,
+                              const void *data, size_t size, std::vector<bool> *results)
+{
+    return CommunicateInterface::sendBatch(dest_list, data, size, results);
+}
+
+std::shared_ptr<const CommunicateInterface::EndpointHandle> KcpCommunicate::resolveEndpoint(
+    const std::string &addr, int port)
+{
+    return CommunicateInterface::resolveEndpoint(addr, port);
+}
+
+bool KcpCommunicate::sendTo(const EndpointHandle &endpoint, const void *data, size_t size)
+{
+    return CommunicateInterface::sendTo(endpoint, data, size);
+}
+
+bool KcpCommunicate::sendOwnedTo(const EndpointHandle &endpoint, std::shared_ptr<const void> data, size_t size)
+{
+    return CommunicateInterface::sendOwnedTo(endpoint, std::move(data), size);
+}
+
+int KcpCommunicate::sendBurst(const std::vector<OutgoingMessage> &messages, std::vector<bool> *results)
+{
+    return CommunicateInterface::sendBurst(messages, results);
+}
+
+void KcpCommunicate::shutdown()
+{
+    LOG_INFO("Shutting down KCP communication");
+    pimpl_->stop();
+    UdpCommunicateCore::shutdown();
+}
+
+#endif // DUAL_ENDPOINT_MODE
@@ -0,0 +1,76 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        kcp_communicate.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 基于KCP的可靠UDP通信（双端均部署该库时使用，需DUAL_ENDPOINT_MODE编译）
+    1. 复用UDP核心的监听socket收发：各KCP会话的数据报均经监听socket发出，对端回复同样回到监听socket
+    2. 同一监听socket上的会话按 (对端地址, conv) 区分；首次向某对端发送时由本端分配conv，
+       收到未知conv的数据报时自动建立会话（对端发起）
+    3. 收齐的消息按UDP相同的订阅规则交给订阅者
+    4. 更新线程按 ikcp_check 给出的时刻在分层时间轮中调度各会话的 ikcp_update，
+       没有待发送、待确认数据的会话不再定时更新，仅在空闲超时时检查一次；KCP内存经 ikcp_allocator 走分级内存池
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef KCP_COMMUNICATE_H_
+#define KCP_COMMUNICATE_H_
+
+#ifdef DUAL_ENDPOINT_MODE
+
+#include "../udp/udp_core.h"
+
+#include <memory>
+#include <string>
+
+class KcpCommunicate : public UdpCommunicateCore
+{
+public:
+    KcpCommunicate();
+    ~KcpCommunicate() override;
+
+    // 禁止拷贝
+    KcpCommunicate(const KcpCommunicate &) = delete;
+    KcpCommunicate &operator=(const KcpCommunicate &) = delete;
+
+    int initialize() override;
+    // 消息交给与目标的KCP会话可靠发送（单条消息上限约 127 * (kcp_mtu - 24) 字节）
+    bool send(const std::string &dest_addr, int dest_port, const void *data, size_t size) override;
+    // 以下发送方式均转为 send，经KCP会话发送
+    bool sendv(const std::string &dest_addr, int dest_port, const communicate::iovec *iov, int iovcnt) override;
+    bool sendOwned(const std::string &dest_addr, int dest_port, std::shared_ptr<const void> data, size_t size) override;
+    int sendBatch(const std::vector<std::pair<std::string, int>> &dest_list,
+                  const void *data, size_t size, std::vector<bool> *results = nullptr) override;
+    std::shared_ptr<const EndpointHandle> resolveEndpoint(const std::string &addr, int port) override;
+    bool sendTo(const EndpointHandle &endpoint, const void *data, size_t size) override;
+    bool sendOwnedTo(const EndpointHandle &endpoint, std::shared_ptr<const void> data, size_t size) override;
+    int sendBurst(const std::vector<OutgoingMessage> &messages, std::vector<bool> *results = nullptr) override;
+    void shutdown() override;
+
+protected:
+    // KCP参数（含义同 ikcp_nodelay / ikcp_wndsize / ikcp_setmtu）
+    struct KcpConfig
+    {
+        int nodelay = 1;                // 1 为启用nodelay模式（RTO最小值更低、退避更缓）
+        int interval = 10;              // 内部更新间隔(毫秒)
+        int resend = 2;                 // 快速重传触发的跳过ACK次数，0 为关闭
+        int nc = 1;                     // 1 为关闭拥塞控制
+        int snd_wnd = 128;              // 发送窗口（包数）
+        int rcv_wnd = 128;              // 接收窗口（包数），不小于128
+        int mtu = 1400;                 // 单个数据报最大长度（含KCP头24字节）
+        int session_timeout_ms = 60000; // 会话无收发且无待确认数据超过该时长后释放
+    } m_kcp_config;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+#endif // DUAL_ENDPOINT_MODE
+
+#endif // KCP_COMMUNICATE_H_
@@ -0,0 +1,357 @@
+#include "periodic_scheduler.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#include "logger_define.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// 忙等循环的让步提示：降低功耗并让出超线程的执行资源
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+} // namespace
+
+PeriodicScheduler::PeriodicScheduler(CommunicateInterface &sender)
+    : sender_(sender), wheel_(toTick(nowNs()))
+{
+}
+
+PeriodicScheduler::~PeriodicScheduler()
+{
+    stop();
+}
+
+uint64_t PeriodicScheduler::nowNs()
+{
+#ifdef __linux__
+    // 与 timerfd 的绝对时间同为 CLOCK_MONOTONIC
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+bool PeriodicScheduler::add(int id, uint64_t period_num, uint64_t period_den, EndpointPtr endpoint, Generator generator)
+{
+    if (period_den == 0 || period_num < period_den || !generator)
+        return false;
+    return insert(std::make_shared<Task>(Task{id, period_num / period_den, period_num % period_den, period_den,
+                                              std::move(endpoint), std::move(generator), nullptr}));
+}
+
+bool PeriodicScheduler::addFixed(int id, uint64_t period_num, uint64_t period_den, EndpointPtr endpoint, Payload data)
+{
+    if (period_den == 0 || period_num < period_den || !data)
+        return false;
+    return insert(std::make_shared<Task>(Task{id, period_num / period_den, period_num % period_den, period_den,
+                                              std::move(endpoint), nullptr, std::move(data)}));
+}
+
+bool PeriodicScheduler::insert(TaskPtr task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_ || tasks_.find(task->id))
+        return false;
+
+    if (!thread_.joinable())
+    {
+#ifdef __linux__
+        timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (timer_fd_ < 0)
+        {
+            LOG_ERROR("Failed to create periodic scheduler timer: {}", strerror(errno));
+            return false;
+        }
+#endif
+        thread_ = std::thread(&PeriodicScheduler::run, this);
+        LOG_DEBUG("Periodic scheduler thread started");
+    }
+
+    task->deadline = nowNs();
+    wheel_.schedule(toTick(task->deadline), task);
+    tasks_.emplace(task->id, task);
+    wakeAt(task->deadline);
+    return true;
+}
+
+bool PeriodicScheduler::remove(int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    TaskPtr *task = tasks_.find(id);
+    if (!task)
+        return false;
+    (*task)->removed = true;
+    tasks_.erase(id);
+    return true;
+}
+
+size_t PeriodicScheduler::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+bool PeriodicScheduler::stats(int id, communicate::PeriodicTaskStats &stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const TaskPtr *found = tasks_.find(id);
+    if (!found)
+        return false;
+    const Task &task = **found;
+    stats.period_ns = task.period_ns;
+    stats.sends = task.sends;
+    stats.missed = task.missed;
+    stats.late_mean_ns = static_cast<uint64_t>(task.late_mean);
+    stats.late_max_ns = task.late_max;
+    stats.jitter_ns = task.sends > 1 ? static_cast<uint64_t>(std::sqrt(task.late_m2 / task.sends)) : 0;
+    return true;
+}
+
+void PeriodicScheduler::setSpin(uint64_t spin_ns)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    spin_ns_ = spin_ns;
+}
+
+void PeriodicScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_)
+            return;
+        stopped_ = true;
+        wakeAt(0);
+    }
+    if (thread_.joinable())
+        thread_.join();
+#ifdef __linux__
+    if (timer_fd_ >= 0)
+    {
+        close(timer_fd_);
+        timer_fd_ = -1;
+    }
+#endif
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.clear();
+}
+
+void PeriodicScheduler::wakeAt(uint64_t ns)
+{
+    if (ns >= wake_at_)
+        return;
+    wake_at_ = ns;
+#ifdef __linux__
+    // 绝对时间设定，全0表示停止定时器，因此至少为1ns（已过去的时刻立即触发）
+    itimerspec spec = {};
+    ns = ns > 0 ? ns : 1;
+    spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000ull);
+    spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000ull);
+    timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+#else
+    cv_.notify_one();
+#endif
+}
+
+void PeriodicScheduler::advanceDeadline(Task &task, uint64_t now)
+{
+    auto step = [&task](uint64_t periods) {
+        task.deadline += task.period_ns * periods;
+        task.rem_acc += task.period_rem * periods;
+        task.deadline += task.rem_acc / task.period_den;
+        task.rem_acc %= task.period_den;
+    };
+
+    step(1);
+    if (task.deadline > now)
+        return;
+
+    // 落后超过一个周期：跳过错过的周期，下次在 now 之后的第一个截止时刻发送
+    uint64_t skipped = (now - task.deadline) / (task.period_ns + (task.period_rem ? 1 : 0));
+    step(skipped);
+    while (task.deadline <= now)
+    {
+        step(1);
+        ++skipped;
+    }
+    if (task.missed == 0)
+        LOG_WARNING("Periodic task {} fell behind, skipping {} missed sends", task.id, skipped);
+    task.missed += skipped;
+}
+
+void PeriodicScheduler::run()
+{
+#ifdef __linux__
+    // 默认 50us 的 timer slack 会直接叠加到每次唤醒上
+    prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0);
+#endif
+    std::vector<Fired> due;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_)
+    {
+        uint64_t now = nowNs();
+        due.clear();
+        wheel_.advance(toTick(now), [&due](uint64_t, TaskPtr &task) {
+            if (!task->removed)
+                due.push_back({std::move(task), 0});
+        });
+
+        if (!due.empty())
+        {
+            // 先登记下一次截止时刻再发送，发送期间删除的任务在下次到期时丢弃
+            for (auto &fired : due)
+            {
+                Task &task = *fired.task;
+                fired.deadline = task.deadline;
+                advanceDeadline(task, now);
+                wheel_.schedule(toTick(task.deadline), fired.task);
+            }
+            lock.unlock();
+            uint64_t sent_at = sendDue(due);
+            lock.lock();
+
+            for (auto &fired : due)
+            {
+                Task &task = *fired.task;
+                if (task.removed)
+                    continue;
+                uint64_t late = sent_at > fired.deadline ? sent_at - fired.deadline : 0;
+                ++task.sends;
+                double delta = static_cast<double>(late) - task.late_mean;
+                task.late_mean += delta / static_cast<double>(task.sends);
+                task.late_m2 += delta * (static_cast<double>(late) - task.late_mean);
+                if (late > task.late_max)
+                    task.late_max = late;
+            }
+            continue;
+        }
+
+        uint64_t next = wheel_.nextExpiry();
+        uint64_t wake_ns = next == UINT64_MAX ? UINT64_MAX : next * 1000;
+        wake_at_ = UINT64_MAX;
+        if (wake_ns != UINT64_MAX && wake_ns <= now + spin_ns_)
+        {
+            // 截止前的最后一段忙等，避开定时器唤醒的延迟
+            // 忙等期间新增任务或停止时 wake_at_ 被提前，随即回到循环开头重新查看时间轮
+            lock.unlock();
+            while (nowNs() < wake_ns)
+            {
+                cpuRelax();
+                lock.lock();
+                if (wake_at_ != UINT64_MAX)
+                    break;
+                lock.unlock();
+            }
+            if (!lock.owns_lock())
+                lock.lock();
+            continue;
+        }
+#ifdef __linux__
+        if (wake_ns == UINT64_MAX)
+        {
+            // 没有任务时停止定时器，添加任务时重新设定
+            itimerspec spec = {};
+            timerfd_settime(timer_fd_, 0, &spec, nullptr);
+        }
+        else
+        {
+            wakeAt(wake_ns - spin_ns_);
+        }
+        lock.unlock();
+        uint64_t expirations = 0;
+        if (read(timer_fd_, &expirations, sizeof(expirations)) < 0 && errno != EINTR)
+            LOG_ERROR("Periodic scheduler timer read failed: {}", strerror(errno));
+        lock.lock();
+#else
+        if (wake_ns == UINT64_MAX)
+        {
+            cv_.wait(lock);
+        }
+        else
+        {
+            wake_at_ = wake_ns - spin_ns_;
+            cv_.wait_until(lock, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(wake_at_)));
+        }
+#endif
+    }
+    LOG_DEBUG("Periodic scheduler thread stopped");
+}
+
+uint64_t PeriodicScheduler::sendDue(std::vector<Fired> &due)
+{
+    std::vector<TaskPtr> failed_tasks;
+    payloads_.resize(due.size());
+    messages_.clear();
+    for (size_t i = 0; i < due.size(); ++i)
+    {
+        Task &task = *due[i].task;
+        if (task.fixed)
+        {
+            messages_.push_back({task.endpoint.get(), task.fixed->data(), task.fixed->size()});
+            continue;
+        }
+        try
+        {
+            payloads_[i] = task.generator();
+        }
+        catch (const std::exception &e)
+        {
+            LOG_ERROR("Periodic task {} data generator failed: {}", task.id, e.what());
+            failed_tasks.push_back(due[i].task);
+            continue;
+        }
+        if (payloads_[i].empty())
+        {
+            LOG_WARNING("Periodic task {} generated empty data", task.id);
+            continue;
+        }
+        messages_.push_back({task.endpoint.get(), payloads_[i].data(), payloads_[i].size()});
+    }
+
+    uint64_t sent_at = nowNs();
+    if (!messages_.empty())
+    {
+        int failed = sender_.sendBurst(messages_);
+        if (failed > 0)
+            LOG_WARNING("Periodic burst: {} of {} messages failed", failed, messages_.size());
+    }
+
+    // 生成器抛出异常的任务不再调度
+    if (!failed_tasks.empty())
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &task : failed_tasks)
+        {
+            TaskPtr *current = tasks_.find(task->id);
+            if (current && *current == task)
+                tasks_.erase(task->id);
+            task->removed = true;
+        }
+    }
+    return sent_at;
+}
@@ -0,0 +1,129 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        periodic_scheduler.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 周期发送任务调度（所有任务共用一个调度线程）
+    1. 任务按微秒tick登记在分层时间轮中，增删均为 O(1)；删除只做标记，时间轮中的条目到期时丢弃，无需等待线程
+    2. 每个任务记录纳秒精度的绝对截止时刻，周期以分数（period_num / period_den 纳秒）累加，
+       300Hz 等不能整除的频率长期平均无偏差，发送耗时也不会累积为周期漂移；落后超过一个周期时跳过错过的发送
+    3. 调度线程休眠至最近的截止时刻（Linux 下为绝对时间的 timerfd，并把线程的 timer slack 降到1ns；其他平台为条件变量），
+       可配置在截止前最后一段时间忙等以进一步降低抖动；同一时刻到期的任务先生成全部数据，再经 sendBurst 一并发出
+    4. 统计每个任务实际发送时刻相对截止时刻的延迟（均值、最大值、标准差）与跳过的周期数
+    5. 调度线程在添加首个任务时创建
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef PERIODIC_SCHEDULER_H_
+#define PERIODIC_SCHEDULER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "communicate_interface.h"
+#include "utils/flat_hash_map.h"
+#include "utils/timer_wheel.h"
+
+class PeriodicScheduler
+{
+public:
+    using Generator = std::function<std::vector<char>()>;
+    using Payload = std::shared_ptr<const std::vector<char>>;
+    using EndpointPtr = std::shared_ptr<const CommunicateInterface::EndpointHandle>;
+
+    // 到期的数据经 sender 的 sendBurst 发出，sender 须比调度器存活更久
+    explicit PeriodicScheduler(CommunicateInterface &sender);
+    ~PeriodicScheduler();
+
+    PeriodicScheduler(const PeriodicScheduler &) = delete;
+    PeriodicScheduler &operator=(const PeriodicScheduler &) = delete;
+
+    /**
+     * @brief 添加任务，首次发送立即进行，之后每 period_num / period_den 纳秒发送一次
+     * @return id 已存在、周期为0或调度器已停止时返回false
+     */
+    bool add(int id, uint64_t period_num, uint64_t period_den, EndpointPtr endpoint, Generator generator);
+    // 每次发送同一份数据，无需每周期生成与拷贝
+    bool addFixed(int id, uint64_t period_num, uint64_t period_den, EndpointPtr endpoint, Payload data);
+    // 删除任务并立即返回：已取出的一轮发送仍可能完成，之后不再调用该任务的生成器
+    bool remove(int id);
+    size_t size() const;
+    // 任务的调度统计，任务不存在时返回false
+    bool stats(int id, communicate::PeriodicTaskStats &stats) const;
+    // 截止时刻前忙等的时长（纳秒），0 为不忙等
+    void setSpin(uint64_t spin_ns);
+    // 停止调度线程（析构时自动调用）
+    void stop();
+
+private:
+    struct Task
+    {
+        int id;
+        uint64_t period_ns;         // 周期的整数部分
+        uint64_t period_rem;        // 周期的分数部分（分子，分母为 period_den）
+        uint64_t period_den;
+        EndpointPtr endpoint;
+        Generator generator;
+        Payload fixed;              // 非空时直接发送，不调用 generator
+        uint64_t deadline = 0;      // 下次发送的绝对截止时刻（纳秒）
+        uint64_t rem_acc = 0;       // 累计的分数部分
+        bool removed = false;
+
+        // 统计（调度线程在 mutex_ 内更新）
+        uint64_t sends = 0;
+        uint64_t missed = 0;
+        uint64_t late_max = 0;
+        double late_mean = 0;
+        double late_m2 = 0;         // 延迟与均值之差的平方和（Welford）
+    };
+    using TaskPtr = std::shared_ptr<Task>;
+
+    // 本轮取出的任务及其截止时刻
+    struct Fired
+    {
+        TaskPtr task;
+        uint64_t deadline;
+    };
+
+    bool insert(TaskPtr task);
+    void run();
+    // 截止时刻推进一个周期，已落后的周期跳过并计入 missed（调用方持有 mutex_）
+    void advanceDeadline(Task &task, uint64_t now);
+    // 生成到期任务的数据并一并发出（不持有锁），返回发出时刻
+    uint64_t sendDue(std::vector<Fired> &due);
+    // 把唤醒时刻提前到 ns（调用方持有 mutex_）
+    void wakeAt(uint64_t ns);
+    static uint64_t nowNs();
+    // 纳秒截止时刻 -> 时间轮tick（向上取整，保证到期时不早于截止时刻）
+    static uint64_t toTick(uint64_t ns) { return (ns + 999) / 1000; }
+
+    CommunicateInterface &sender_;
+    mutable std::mutex mutex_;
+    FlatHashMap<int, TaskPtr> tasks_;
+    TimerWheel<TaskPtr> wheel_;
+    uint64_t wake_at_ = UINT64_MAX;     // 调度线程下次醒来的时刻（纳秒）
+    uint64_t spin_ns_ = 0;
+    bool stopped_ = false;
+#ifdef __linux__
+    int timer_fd_ = -1;
+#else
+    std::condition_variable cv_;
+#endif
+    std::thread thread_;
+
+    // 调度线程复用的缓冲
+    std::vector<std::vector<char>> payloads_;
+    std::vector<CommunicateInterface::OutgoingMessage> messages_;
+};
+
+#endif // PERIODIC_SCHEDULER_H_
@@ -0,0 +1,166 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        subscriber_router.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 订阅者路由表（UDP/TCP共用）
+    1. 订阅地址打包为整数键：IPv4地址(32位) + 端口(16位) + 类型
+    2. 匹配顺序：精确发送方 -> 精确本地 -> 通配绑定地址(0.0.0.0)+本地端口 -> localhost+本地端口 -> 完全通配
+       本地地址取自数据报实际目的地址，0.0.0.0 一级保证按 INADDR_ANY 绑定地址订阅的用法仍能匹配
+    3. FlowCache 按 (发送方, 本地) 缓存匹配结果，命中时只需一次哈希查找；
+       路由表变化时版本号递增，各缓存在下次查询时整体失效
+    4. 路由表以 RCU 快照发布，未命中缓存时的查找同样不加锁
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef SUBSCRIBER_ROUTER_H_
+#define SUBSCRIBER_ROUTER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#endif
+
+#include "communicate_api.h"
+#include "utils/rcu_snapshot.h"
+
+class SubscriberRouter
+{
+public:
+    using Subscriber = communicate::SubscribebBase;
+
+    // 路由键类型（位于键的高16位）
+    enum KeyKind : uint64_t
+    {
+        KEY_ENDPOINT = 0,   // 精确 IP:端口（发送方或本地）
+        KEY_LOCALHOST = 1,  // "localhost":端口，匹配任意本地IP的该端口
+        KEY_ANY = 2,        // "":0，完全通配
+    };
+
+    // 由网络字节序地址生成端点键
+    static uint64_t endpointKey(const sockaddr_in &addr)
+    {
+        return endpointKey(ntohl(addr.sin_addr.s_addr), ntohs(addr.sin_port));
+    }
+
+    static uint64_t endpointKey(uint32_t ip, uint16_t port)
+    {
+        return (KEY_ENDPOINT << 48) | (static_cast<uint64_t>(ip) << 16) | port;
+    }
+
+    /**
+     * @brief 由订阅地址生成路由键
+     * @param addr  IPv4地址；"localhost" 表示本地任意地址，"" 表示通配
+     * @return 地址无法解析时返回false
+     */
+    static bool makeKey(const std::string &addr, int port, uint64_t &key)
+    {
+        uint16_t port16 = static_cast<uint16_t>(port);
+        if (addr.empty())
+        {
+            key = (KEY_ANY << 48) | port16;     // 仅 "":0 会被匹配
+            return true;
+        }
+        if (addr == "localhost")
+        {
+            key = (KEY_LOCALHOST << 48) | port16;
+            return true;
+        }
+        in_addr ip = {};
+        if (inet_pton(AF_INET, addr.c_str(), &ip) != 1)
+            return false;
+        key = endpointKey(ntohl(ip.s_addr), port16);
+        return true;
+    }
+
+    void add(uint64_t key, Subscriber *sub)
+    {
+        table_.update([&](Table &table) { table[key] = sub; });
+    }
+
+    uint64_t version() const { return table_.version(); }
+
+    // 按匹配顺序查找订阅者，未找到返回nullptr
+    Subscriber *resolve(uint64_t src_key, uint64_t local_key) const
+    {
+        const uint64_t keys[] = {
+            src_key,                                    // 精确发送方
+            local_key,                                  // 精确本地
+            endpointKey(0, static_cast<uint16_t>(local_key)), // 通配绑定地址 0.0.0.0+本地端口
+            (KEY_LOCALHOST << 48) | (local_key & 0xFFFF), // 本地通用匹配前缀+指定端口
+            KEY_ANY << 48,                              // 完全通配
+        };
+        auto table = table_.read();
+        for (uint64_t key : keys)
+        {
+            auto it = table->find(key);
+            if (it != table->end())
+                return it->second;
+        }
+        return nullptr;
+    }
+
+    // 流路由缓存，每个接收线程持有一个（非线程安全）
+    class FlowCache
+    {
+    public:
+        Subscriber *route(const SubscriberRouter &router, uint64_t src_key, uint64_t local_key)
+        {
+            uint64_t version = router.version();
+            if (version != version_ || flows_.size() >= MAX_FLOWS)
+            {
+                // 路由表变化（或缓存的流过多）时整体失效
+                flows_.clear();
+                version_ = version;
+            }
+
+            FlowKey flow{src_key, local_key};
+            auto it = flows_.find(flow);
+            if (it != flows_.end())
+                return it->second;
+
+            Subscriber *sub = router.resolve(src_key, local_key);
+            flows_.emplace(flow, sub);
+            return sub;
+        }
+
+    private:
+        static constexpr size_t MAX_FLOWS = 4096;
+
+        struct FlowKey
+        {
+            uint64_t src;
+            uint64_t local;
+            bool operator==(const FlowKey &other) const { return src == other.src && local == other.local; }
+        };
+
+        struct FlowKeyHash
+        {
+            size_t operator()(const FlowKey &key) const
+            {
+                return std::hash<uint64_t>()(key.src * 0x9E3779B97F4A7C15ULL ^ key.local);
+            }
+        };
+
+        uint64_t version_ = ~0ULL;
+        std::unordered_map<FlowKey, Subscriber *, FlowKeyHash> flows_;
+    };
+
+private:
+    using Table = std::unordered_map<uint64_t, Subscriber *>;
+    RcuSnapshot<Table> table_;
+};
+
+#endif // SUBSCRIBER_ROUTER_H_
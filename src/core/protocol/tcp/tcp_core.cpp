@@ -16,6 +16,11 @@ public:
             LOG_ERROR("WSAStartup failed");
         else
             LOG_DEBUG("WSAStartup successful");
+#endif
+#ifdef IO_URING_MODE
+        wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeup_fd_ < 0)
+            LOG_ERROR("Failed to create wakeup eventfd: {}", strerror(errno));
 #endif
     }
 
@@ -27,6 +32,10 @@ public:
 #ifdef _WIN32
         WSACleanup();
         LOG_DEBUG("WSACleanup called");
+#endif
+#ifdef IO_URING_MODE
+        if (wakeup_fd_ >= 0)
+            close(wakeup_fd_);
 #endif
     }
 
@@ -35,6 +44,9 @@ public:
         LOG_TRACE("Start listening for TCP connections");
         if (!is_running_.exchange(true))
         {
+            // 接收缓冲由内核直接写入后交给订阅者
+            recv_pool_ = BufferPool::create(config_.max_send_packet_size, config_.recv_pool_size);
+
             LOG_INFO("Starting TCP acceptor thread");
             acceptor_thread_ = std::thread(&Impl::acceptorLoop, this);
             
@@ -52,6 +64,9 @@ public:
             
             // 通知所有线程停止
             stop_signal_.notify_all();
+#ifdef IO_URING_MODE
+            wakeupReceiver();
+#endif
             
             if (acceptor_thread_.joinable())
             {
@@ -76,7 +91,8 @@ public:
         std::lock_guard<std::mutex> lock(socket_mutex_);
 
         // 检查是否已存在该地址的监听
-        for (const auto &sock : listen_sockets_)
+        auto sockets = listen_sockets_.read();
+        for (const auto &sock : *sockets)
         {
             if (sock.addr_port == key)
             {
@@ -104,7 +120,9 @@ public:
             return false;
         }
 
-        listen_sockets_.push_back({sockfd, key});
+        listen_sockets_.update([&](std::vector<ListeningSocket> &sockets) {
+            sockets.push_back({sockfd, key});
+        });
         LOG_INFO("Added listening socket for {}:{}", addr, port);
         return true;
     }
@@ -142,6 +160,7 @@ public:
         conn.fd = sockfd;
         conn.remote_addr = addr;
         conn.remote_port = port;
+        SubscriberRouter::makeKey(addr, port, conn.remote_key);
 
         // 获取本地地址信息
         sockaddr_in local_addr = {};
@@ -152,8 +171,12 @@ public:
             inet_ntop(AF_INET, &local_addr.sin_addr, ip, INET_ADDRSTRLEN);
             conn.local_addr = ip;
             conn.local_port = ntohs(local_addr.sin_port);
+            conn.local_key = SubscriberRouter::endpointKey(local_addr);
         }
 
+#ifdef __linux__
+        conn.zerocopy = std::make_shared<ZeroCopyTracker>(sockfd);
+#endif
         connections_[key] = conn;
         LOG_INFO("Connected to {}:{}", addr, port);
         // 成功创建后增加计数
@@ -161,27 +184,120 @@ public:
         return true;
     }
 
+    // owner 非空表示调用方已转移数据所有权，大块数据可使用零拷贝发送
     bool sendData(const std::string &dest_addr, int dest_port,
-                  const void *data, size_t size)
+                  const void *data, size_t size, const std::shared_ptr<const void> &owner = nullptr)
     {
         LOG_TRACE("Attempting to send {} bytes to {}:{}", size, dest_addr, dest_port);
 
-        SocketType sockfd = getConnection(dest_addr, dest_port);
+        std::shared_ptr<ZeroCopyTracker> zerocopy;
+        SocketType sockfd = acquireConnection(dest_addr, dest_port, &zerocopy);
+        if (sockfd == INVALID_SOCKET)
+        {
+            return false;
+        }
+
+#ifdef __linux__
+        if (owner && zerocopy && config_.zerocopy_threshold > 0 &&
+            size >= static_cast<size_t>(config_.zerocopy_threshold))
+            return doSendZeroCopy(sockfd, *zerocopy, data, size, owner);
+#endif
+        return doSend(sockfd, data, size);
+    }
+
+    bool sendDataV(const std::string &dest_addr, int dest_port, const communicate::iovec *iov, int iovcnt)
+    {
+        LOG_TRACE("Attempting to send {} buffers to {}:{}", iovcnt, dest_addr, dest_port);
+
+        SocketType sockfd = acquireConnection(dest_addr, dest_port);
+        if (sockfd == INVALID_SOCKET)
+        {
+            return false;
+        }
+        return doSendV(sockfd, iov, static_cast<size_t>(iovcnt));
+    }
+
+    // 取得到目标的连接，不存在时新建
+    SocketType acquireConnection(const std::string &dest_addr, int dest_port,
+                                 std::shared_ptr<ZeroCopyTracker> *zerocopy = nullptr)
+    {
+        SocketType sockfd = getConnection(dest_addr, dest_port, zerocopy);
         if (sockfd == INVALID_SOCKET)
         {
             LOG_WARNING("No existing connection, creating new one");
             if (!connectToServer(dest_addr, dest_port))
             {
-                return false;
+                return INVALID_SOCKET;
             }
-            sockfd = getConnection(dest_addr, dest_port);
-            if (sockfd == INVALID_SOCKET)
+            sockfd = getConnection(dest_addr, dest_port, zerocopy);
+        }
+        return sockfd;
+    }
+
+    // 多段数据视为一条连续消息：每次最多发送 max_send_packet_size 字节，跨越 iovec 边界的部分合并为一次 sendmsg
+    bool doSendV(SocketType sockfd, const communicate::iovec *iov, size_t iovcnt)
+    {
+#ifdef _WIN32
+        std::vector<char> joined;
+        for (size_t i = 0; i < iovcnt; ++i)
+        {
+            const char *base = static_cast<const char *>(iov[i].iov_base);
+            joined.insert(joined.end(), base, base + iov[i].iov_len);
+        }
+        return doSend(sockfd, joined.data(), joined.size());
+#else
+        constexpr size_t MAX_WINDOW = 64;   // 单次 sendmsg 最多携带的片段数
+        const size_t packet_size = static_cast<size_t>(config_.max_send_packet_size);
+        size_t size = 0;
+        for (size_t i = 0; i < iovcnt; ++i)
+        {
+            size += iov[i].iov_len;
+        }
+
+        size_t index = 0, inner = 0;    // 当前 iovec 及其内偏移
+        size_t sent_total = 0;
+        while (sent_total < size)
+        {
+            iovec window[MAX_WINDOW];
+            size_t count = 0, chunk_size = 0;
+            for (size_t i = index, offset = inner; i < iovcnt && count < MAX_WINDOW && chunk_size < packet_size; ++i, offset = 0)
             {
+                size_t take = std::min(iov[i].iov_len - offset, packet_size - chunk_size);
+                if (take > 0)
+                    window[count++] = {static_cast<char *>(iov[i].iov_base) + offset, take};
+                chunk_size += take;
+            }
+
+            msghdr msg = {};
+            msg.msg_iov = window;
+            msg.msg_iovlen = count;
+            ssize_t sent_bytes = sendmsg(sockfd, &msg, 0);
+            if (sent_bytes <= 0)
+            {
+                LOG_ERROR("Failed to send chunk (error: {})", strerror(errno));
+                LOG_ERROR("Failed to send complete message");
                 return false;
             }
+
+            // 按实际发送的字节数推进游标（可能只发出部分）
+            sent_total += static_cast<size_t>(sent_bytes);
+            size_t advance = static_cast<size_t>(sent_bytes);
+            while (advance > 0)
+            {
+                size_t take = std::min(advance, iov[index].iov_len - inner);
+                advance -= take;
+                inner += take;
+                if (inner == iov[index].iov_len)
+                {
+                    ++index;
+                    inner = 0;
+                }
+            }
         }
 
-        return doSend(sockfd, data, size);
+        LOG_DEBUG("Successfully sent {} bytes", size);
+        return true;
+#endif
     }
 
     bool doSend(SocketType sockfd, const void* data, size_t size)
@@ -217,25 +333,59 @@ public:
         return success;
     }
 
-    void addSubscriber(const std::string &key, communicate::SubscribebBase *sub)
+#ifdef __linux__
+    // 零拷贝发送：整段数据交给内核（不按 max_send_packet_size 切分，避免每片单独锁页并产生一次通知），
+    // owner 由跟踪器持有至完成通知；socket不支持或内核退化为拷贝时改为普通发送
+    bool doSendZeroCopy(SocketType sockfd, ZeroCopyTracker &tracker, const void *data, size_t size,
+                        const std::shared_ptr<const void> &owner)
     {
-        LOG_DEBUG("Adding subscriber for key: {}", key);
-        std::unique_lock<std::shared_mutex> lock(sub_mutex_);
-        subscribers_[key] = sub;
-    }
+        std::lock_guard<std::mutex> lock(tracker.mutex());
+        bool usable = tracker.usable();
+        if (tracker.takeCopiedNotice())
+            LOG_INFO("Kernel copied zerocopy sends on socket {}, using regular send", sockfd);
+        if (!usable)
+            return doSend(sockfd, data, size);
 
-    communicate::SubscribebBase *getSubscriber(const std::string &key)
-    {
-        LOG_TRACE("Get subscriber for key: {}", key);
-        std::shared_lock<std::shared_mutex> lock(sub_mutex_);
-        auto it = subscribers_.find(key);
-        LOG_DEBUG("Success subscriber for key: {}", it != subscribers_.end() ? key : "");
-        return it != subscribers_.end() ? it->second : nullptr;
+        const char *data_ptr = reinterpret_cast<const char *>(data);
+        size_t remaining = size;
+        while (remaining > 0)
+        {
+            iovec iov = {const_cast<char *>(data_ptr), remaining};
+            msghdr msg = {};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            ssize_t sent_bytes = tracker.sendmsg(msg, 0, owner);
+            if (sent_bytes <= 0)
+            {
+                if (sent_bytes < 0 && errno == ENOBUFS)
+                {
+                    // 锁定页数超过 optmem 限制且等待通知后仍不足，剩余部分拷贝发送
+                    LOG_WARNING("Zerocopy send out of option memory, {} bytes sent by copy", remaining);
+                    return doSend(sockfd, data_ptr, remaining);
+                }
+                LOG_ERROR("Failed to send zerocopy chunk (error: {})", strerror(errno));
+                return false;
+            }
+            data_ptr += sent_bytes;
+            remaining -= sent_bytes;
+        }
+
+        LOG_DEBUG("Successfully sent {} bytes (zerocopy, {} sends pending)", size, tracker.pending());
+        return true;
     }
+#endif
 
-    static std::string createSubKey(const std::string &addr, int port)
+    bool addSubscriber(const std::string &addr, int port, communicate::SubscribebBase *sub)
     {
-        return addr + ":" + std::to_string(port);
+        uint64_t key = 0;
+        if (!SubscriberRouter::makeKey(addr, port, key))
+        {
+            LOG_ERROR("Invalid subscribe address {}:{}", addr, port);
+            return false;
+        }
+        LOG_DEBUG("Adding subscriber for {}:{} (key {:#x})", addr, port, key);
+        router_.add(key, sub);
+        return true;
     }
 
 private:
@@ -252,6 +402,11 @@ private:
         int remote_port;
         std::string local_addr;
         int local_port;
+        uint64_t remote_key = 0;    // 订阅路由键（见 SubscriberRouter）
+        uint64_t local_key = 0;
+#ifdef __linux__
+        std::shared_ptr<ZeroCopyTracker> zerocopy;  // 仅主动连接，零拷贝发送的完成跟踪
+#endif
 
         operator SocketType() const { return fd; }
     };
@@ -260,11 +415,39 @@ private:
     {
         LOG_INFO("Acceptor thread started");
         
+#ifdef _WIN32
+        std::vector<WSAPOLLFD> pollfds;
+#else
+        std::vector<pollfd> pollfds;
+#endif
+        uint64_t sockets_version = ~0ULL;
+#ifdef __linux__
+        auto last_reap = std::chrono::steady_clock::now();
+#endif
         while (is_running_.load())
         {
-            std::vector<ListeningSocket> sockets = getCurrentListenSockets();
+#ifdef __linux__
+            // 发送后不再有后续发送的连接，其零拷贝完成通知由此回收，调用方的缓冲得以及时释放
+            auto now = std::chrono::steady_clock::now();
+            if (now - last_reap >= std::chrono::milliseconds(ZeroCopyTracker::REAP_INTERVAL_MS))
+            {
+                last_reap = now;
+                reapZeroCopy();
+            }
+#endif
+            // 监听socket集合变化时才重建poll集合
+            if (listen_sockets_.version() != sockets_version)
+            {
+                sockets_version = listen_sockets_.version();
+                auto sockets = listen_sockets_.read();
+                pollfds.clear();
+                for (const auto &sock : *sockets)
+                {
+                    pollfds.push_back({sock.fd, POLLIN, 0});
+                }
+            }
 
-            if (sockets.empty())
+            if (pollfds.empty())
             {
                 LOG_TRACE("No sockets to accept, sleeping");
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -273,18 +456,8 @@ private:
 
             // 使用poll检查哪些监听socket有新的连接
 #ifdef _WIN32
-            std::vector<WSAPOLLFD> pollfds;
-            for (const auto &sock : sockets)
-            {
-                pollfds.push_back({sock.fd, POLLIN, 0});
-            }
             int ret = WSAPoll(pollfds.data(), static_cast<ULONG>(pollfds.size()), 100);
 #else
-            std::vector<pollfd> pollfds;
-            for (const auto &sock : sockets)
-            {
-                pollfds.push_back({sock.fd, POLLIN, 0});
-            }
             int ret = poll(pollfds.data(), pollfds.size(), 100);
 #endif
 
@@ -343,7 +516,7 @@ private:
         socklen_t local_addr_len = sizeof(local_addr);
         char local_ip[INET_ADDRSTRLEN] = {0};
         int local_port = 0;
-        if (getsockname(listen_sock, (sockaddr *)&local_addr, &local_addr_len) == 0)
+        if (getsockname(client_sock, (sockaddr *)&local_addr, &local_addr_len) == 0)
         {
             inet_ntop(AF_INET, &local_addr.sin_addr, local_ip, INET_ADDRSTRLEN);
             local_port = ntohs(local_addr.sin_port);
@@ -362,24 +535,56 @@ private:
         conn.remote_port = client_port;
         conn.local_addr = local_ip;
         conn.local_port = local_port;
+        conn.remote_key = SubscriberRouter::endpointKey(client_addr);
+        conn.local_key = SubscriberRouter::endpointKey(local_addr);
         
-        std::lock_guard<std::mutex> lock(conn_mutex_);
-        active_connections_[client_sock] = conn;
+        {
+            std::lock_guard<std::mutex> lock(conn_mutex_);
+            active_connections_.update([&](ConnectionMap &connections) {
+                connections[client_sock] = conn;
+            });
+        }
   
         current_connections_++;
+#ifdef IO_URING_MODE
+        // io_uring 接收循环需被唤醒以挂载新连接的接收请求
+        if (uring_receiving_.load())
+            wakeupReceiver();
+#endif
     }
 
     void receiverLoop()
     {
         LOG_INFO("Receiver thread started");
-        constexpr int BUFFER_SIZE = 65536;
-        char buffer[BUFFER_SIZE];
+#ifdef IO_URING_MODE
+        if (config_.io_backend == "io_uring" && uringReceiverLoop())
+        {
+            LOG_INFO("Receiver thread exiting");
+            return;
+        }
+#endif
 
+#ifdef _WIN32
+        std::vector<WSAPOLLFD> pollfds;
+#else
+        std::vector<pollfd> pollfds;
+#endif
+        uint64_t connections_version = ~0ULL;
         while (is_running_.load())
         {
-            std::vector<SocketType> sockets = getCurrentConnections();
+            // 连接集合变化时才重建poll集合
+            if (active_connections_.version() != connections_version)
+            {
+                connections_version = active_connections_.version();
+                auto connections = active_connections_.read();
+                pollfds.clear();
+                for (const auto &[sockfd, conn] : *connections)
+                {
+                    pollfds.push_back({sockfd, POLLIN, 0});
+                }
+            }
 
-            if (sockets.empty())
+            if (pollfds.empty())
             {
                 LOG_TRACE("No connections to poll, sleeping");
                 std::unique_lock<std::mutex> lock(conn_mutex_);
@@ -389,18 +594,8 @@ private:
 
             // 使用poll检查哪些连接有数据可读
 #ifdef _WIN32
-            std::vector<WSAPOLLFD> pollfds;
-            for (const auto &sock : sockets)
-            {
-                pollfds.push_back({sock, POLLIN, 0});
-            }
             int ret = WSAPoll(pollfds.data(), static_cast<ULONG>(pollfds.size()), 100);
 #else
-            std::vector<pollfd> pollfds;
-            for (const auto &sock : sockets)
-            {
-                pollfds.push_back({sock, POLLIN, 0});
-            }
             int ret = poll(pollfds.data(), pollfds.size(), 100);
 #endif
 
@@ -435,13 +630,14 @@ private:
 
     void processIncomingData(SocketType sockfd)
     {
-        // 使用配置的最大包大小
-        std::vector<char> buffer(config_.max_send_packet_size);
+        // 直接接收到缓冲池的缓冲中，随后整块交给订阅者（避免拷贝）
+        char *buffer = recv_pool_->acquire();
         
         // 接收数据
-        ssize_t recv_len = recv(sockfd, buffer.data(), buffer.size(), 0);
+        ssize_t recv_len = recv(sockfd, buffer, recv_pool_->blockSize(), 0);
         if (recv_len <= 0)
         {
+            recv_pool_->release(buffer);
             if (recv_len == 0)
             {
                 LOG_INFO("Connection closed by peer");
@@ -455,39 +651,34 @@ private:
         }
         
         LOG_DEBUG("Received {} bytes from socket {}", recv_len, sockfd);
-        
-        // 获取连接信息
-        ConnectionInfo conn_info = getConnectionInfo(sockfd);
-        if (conn_info.fd == INVALID_SOCKET)
+        dispatchMessage(sockfd, recv_pool_->share(buffer));
+    }
+
+    void dispatchMessage(SocketType sockfd, std::shared_ptr<void> msg_data)
+    {
+        // 获取连接信息（读取连接表快照，不加锁）
+        communicate::SubscribebBase *sub = nullptr;
+        {
+            auto connections = active_connections_.read();
+            auto it = connections->find(sockfd);
+            if (it == connections->end())
+            {
+                LOG_ERROR("Failed to get connection info");
+                return;
+            }
+
+            // 接收线程内完成匹配，连接的流路由缓存命中时只需一次查找
+            sub = flows_.route(router_, it->second.remote_key, it->second.local_key);
+        }
+        if (!sub)
         {
-            LOG_ERROR("Failed to get connection info");
+            LOG_WARNING("No subscriber found for message");
             return;
         }
 
-        // 复制数据到共享内存
-        auto msg_data = std::shared_ptr<void>(malloc(recv_len), free);
-        memcpy(msg_data.get(), buffer.data(), recv_len);
-
-        // 生成匹配键
-        auto context = std::make_shared<MatchContext>();
-        context->sender_key = createSubKey(conn_info.remote_addr, conn_info.remote_port);
-        context->local_key = createSubKey(conn_info.local_addr, conn_info.local_port);
-        context->wildcard_key = createSubKey("localhost", conn_info.local_port);
-        context->any_key = createSubKey("", 0);
-
         // 生成处理任务
-        auto process_msg = [this, context, msg_data] {
-            if (auto sub = getSubscriber(context->sender_key) ?:
-                           getSubscriber(context->local_key)  ?:
-                           getSubscriber(context->wildcard_key) ?:
-                           getSubscriber(context->any_key))
-            {
-                sub->handleMsg(msg_data);
-            }
-            else
-            {
-                LOG_WARNING("No subscriber found for message");
-            }
+        auto process_msg = [sub, msg_data] {
+            sub->handleMsg(msg_data);
         };
 
 #ifdef THREAD_POOL_MODE
@@ -497,6 +688,119 @@ private:
 #endif
     }
 
+#ifdef IO_URING_MODE
+    void wakeupReceiver()
+    {
+        uint64_t one = 1;
+        if (wakeup_fd_ >= 0 && write(wakeup_fd_, &one, sizeof(one)) != sizeof(one))
+            LOG_WARNING("Failed to wake receiver thread: {}", strerror(errno));
+    }
+
+    // io_uring 接收循环：每个连接挂载一个multishot recv，数据写入提供缓冲环
+    // 返回false表示内核不支持（调用方回退到poll）
+    bool uringReceiverLoop()
+    {
+        constexpr uint16_t URING_BUF_GROUP = 0;
+        constexpr uint64_t WAKEUP_TAG = ~0ULL;
+
+        // 提供给内核的缓冲取自接收缓冲池；须先于 ring 构造，保证 ring 关闭后才归还
+        struct RingBuffers
+        {
+            std::shared_ptr<BufferPool> pool;
+            std::vector<char *> blocks;
+            ~RingBuffers()
+            {
+                for (char *block : blocks)
+                    pool->release(block);
+            }
+        } ring_buffers{recv_pool_, {}};
+        for (int i = 0; i < config_.uring_buf_count; ++i)
+        {
+            ring_buffers.blocks.push_back(recv_pool_->acquire());
+        }
+
+        UringEngine ring;
+        if (wakeup_fd_ < 0 || !ring.init(config_.uring_entries) ||
+            !ring.setupBufferRing(URING_BUF_GROUP, config_.uring_buf_count,
+                                  static_cast<unsigned>(recv_pool_->blockSize()), ring_buffers.blocks.data()))
+        {
+            LOG_WARNING("io_uring receive unavailable ({}), falling back to poll", strerror(errno));
+            return false;
+        }
+
+        uint64_t wakeup_value = 0;
+        std::unordered_set<SocketType> armed;   // 已挂载接收的连接
+        auto armNewConnections = [&] {
+            auto connections = active_connections_.read();
+            for (const auto &[sockfd, conn] : *connections)
+            {
+                if (armed.insert(sockfd).second)
+                    ring.prepRecvMultishot(sockfd, static_cast<uint64_t>(sockfd));
+            }
+        };
+
+        ring.prepRead(wakeup_fd_, &wakeup_value, sizeof(wakeup_value), WAKEUP_TAG);
+        armNewConnections();
+        uring_receiving_.store(true);
+        LOG_INFO("Receiver thread using io_uring backend");
+
+        bool unsupported = false;
+        while (is_running_.load() && !unsupported)
+        {
+            int ret = ring.submit(1);
+            if (ret < 0 && ret != -EINTR)
+            {
+                LOG_ERROR("io_uring submit error: {}", strerror(-ret));
+            }
+
+            ring.drainCompletions([&](const UringEngine::Completion &cqe) {
+                if (cqe.user_data == WAKEUP_TAG)
+                {
+                    // 新连接接入或stop()唤醒
+                    ring.prepRead(wakeup_fd_, &wakeup_value, sizeof(wakeup_value), WAKEUP_TAG);
+                    armNewConnections();
+                    return;
+                }
+
+                SocketType sockfd = static_cast<SocketType>(cqe.user_data);
+                if (cqe.res > 0 && cqe.hasBuffer())
+                {
+                    LOG_DEBUG("Received {} bytes from socket {}", cqe.res, sockfd);
+                    // 缓冲整块交给订阅者，以新缓冲顶替归还内核
+                    uint16_t bid = cqe.bufferId();
+                    dispatchMessage(sockfd, recv_pool_->share(ring.buffer(bid)));
+                    ring_buffers.blocks[bid] = recv_pool_->acquire();
+                    ring.replaceBuffer(bid, ring_buffers.blocks[bid]);
+                }
+                else if (cqe.res == -EINVAL)
+                {
+                    // 内核不支持multishot recv（< 6.0）
+                    LOG_WARNING("io_uring multishot recv not supported by kernel, falling back to poll");
+                    unsupported = true;
+                    return;
+                }
+                else if (cqe.res != -ENOBUFS)
+                {
+                    if (cqe.res == 0)
+                        LOG_INFO("Connection closed by peer");
+                    else
+                        LOG_ERROR("io_uring recv failed on socket {}: {}", sockfd, strerror(-cqe.res));
+                    armed.erase(sockfd);
+                    closeConnection(sockfd);
+                    return;
+                }
+
+                // multishot 请求终止（缓冲耗尽等）时重新挂载
+                if (!cqe.hasMore())
+                    ring.prepRecvMultishot(sockfd, cqe.user_data);
+            });
+        }
+
+        uring_receiving_.store(false);
+        return !unsupported;
+    }
+#endif
+
     SocketType createAndBindSocket(const std::string &addr, int port)
     {
         // 创建TCP Socket
@@ -688,92 +992,85 @@ private:
         
         {
             std::lock_guard<std::mutex> lock(socket_mutex_);
-            for (const auto &sock : listen_sockets_)
-            {
+            listen_sockets_.update([](std::vector<ListeningSocket> &sockets) {
+                for (const auto &sock : sockets)
+                {
 #ifdef _WIN32
-                closesocket(sock.fd);
+                    closesocket(sock.fd);
 #else
-                close(sock.fd);
+                    close(sock.fd);
 #endif
-            }
-            listen_sockets_.clear();
+                }
+                sockets.clear();
+            });
         }
         
+        // 主动建立的连接由 cleanConnections 在等待零拷贝发送完成后关闭
+        cleanConnections();
+
         {
             std::lock_guard<std::mutex> lock(conn_mutex_);
-            for (auto &[_, conn] : connections_)
-            {
-#ifdef _WIN32
-                closesocket(conn.fd);
-#else
-                close(conn.fd);
-#endif
-            }
-            connections_.clear();
-            
-            for (auto &[_, sock] : active_connections_)
-            {
+            active_connections_.update([](ConnectionMap &connections) {
+                for (auto &[_, sock] : connections)
+                {
 #ifdef _WIN32
-                closesocket(sock.fd);
+                    closesocket(sock.fd);
 #else
-                close(sock.fd);
+                    close(sock.fd);
 #endif
-            }
-            active_connections_.clear();
-        }
-    }
-
-    std::vector<ListeningSocket> getCurrentListenSockets()
-    {
-        std::lock_guard<std::mutex> lock(socket_mutex_);
-        return listen_sockets_;
-    }
-
-    std::vector<SocketType> getCurrentConnections()
-    {
-        std::lock_guard<std::mutex> lock(conn_mutex_);
-        std::vector<SocketType> sockets;
-        for (const auto &[sockfd, conn] : active_connections_)
-        {
-            sockets.push_back(sockfd);
-        }
-        return sockets;
-    }
-
-    ConnectionInfo getConnectionInfo(SocketType sockfd)
-    {
-        std::lock_guard<std::mutex> lock(conn_mutex_);
-        auto it = active_connections_.find(sockfd);
-        if (it != active_connections_.end())
-        {
-            return it->second;
+                }
+                connections.clear();
+            });
         }
-        return {INVALID_SOCKET};
     }
 
     void closeConnection(SocketType sockfd)
     {
         std::lock_guard<std::mutex> lock(conn_mutex_);
-        auto it = active_connections_.find(sockfd);
-        if (it != active_connections_.end())
+        if (active_connections_.read()->count(sockfd))
         {
 #ifdef WIN32
             closesocket(sockfd);
 #else
             close(sockfd);
 #endif
-            active_connections_.erase(it);
+            active_connections_.update([&](ConnectionMap &connections) {
+                connections.erase(sockfd);
+            });
             LOG_INFO("Closed connection {}", sockfd);
 
             current_connections_--;
         }
     }
 
+#ifdef __linux__
+    // 回收各主动连接上已完成的零拷贝发送（不阻塞，正在发送的连接跳过）
+    void reapZeroCopy()
+    {
+        std::lock_guard<std::mutex> lock(conn_mutex_);
+        for (auto &[_, conn] : connections_)
+        {
+            if (conn.zerocopy)
+                conn.zerocopy->tryReap();
+        }
+    }
+#endif
+
     void cleanConnections()
     {
         LOG_TRACE("Clean up all connections");
         std::lock_guard<std::mutex> lock(conn_mutex_);
         for (auto& [_, conn] : connections_) {
+#ifdef __linux__
+            if (conn.zerocopy)
+            {
+                // 关闭后内核不再上报完成通知，先等待已发出的零拷贝数据
+                std::lock_guard<std::mutex> zc_lock(conn.zerocopy->mutex());
+                if (!conn.zerocopy->wait(config_.send_timeout_ms))
+                    LOG_WARNING("Closing {}:{} with {} zerocopy sends pending",
+                                conn.remote_addr, conn.remote_port, conn.zerocopy->pending());
+            }
+#endif
             if (conn.fd != INVALID_SOCKET) {
 #ifdef _WIN32
                 closesocket(conn.fd);
@@ -787,22 +1084,22 @@ private:
         current_connections_.store(0);
     }
 
-    SocketType getConnection(const std::string &addr, int port)
+    // zerocopy 非空时一并取出该连接的零拷贝跟踪器（非Linux始终为空）
+    SocketType getConnection(const std::string &addr, int port,
+                             std::shared_ptr<ZeroCopyTracker> *zerocopy = nullptr)
     {
         std::string key = addr + ":" + std::to_string(port);
         std::lock_guard<std::mutex> lock(conn_mutex_);
         auto it = connections_.find(key);
-        return it != connections_.end() ? it->second.fd : INVALID_SOCKET;
+        if (it == connections_.end())
+            return INVALID_SOCKET;
+#ifdef __linux__
+        if (zerocopy)
+            *zerocopy = it->second.zerocopy;
+#endif
+        return it->second.fd;
     }
 
-    struct MatchContext
-    {
-        std::string sender_key;
-        std::string local_key;
-        std::string wildcard_key;
-        std::string any_key;
-    };
-
 private:
     std::atomic<bool> is_running_;
     CoreConfig& config_;
@@ -811,12 +1108,18 @@ private:
     std::thread receiver_thread_;
     std::mutex socket_mutex_;
     std::mutex conn_mutex_;
-    std::shared_mutex sub_mutex_;
     std::condition_variable stop_signal_;
-    std::vector<ListeningSocket> listen_sockets_;
+    using ConnectionMap = std::unordered_map<SocketType, ConnectionInfo>;
+    RcuSnapshot<std::vector<ListeningSocket>> listen_sockets_;  // 写操作在 socket_mutex_ 下进行
     std::unordered_map<std::string, ConnectionInfo> connections_;       // 主动连接池
-    std::unordered_map<SocketType, ConnectionInfo> active_connections_; // 所有活动连接
-    std::unordered_map<std::string, communicate::SubscribebBase *> subscribers_;
+    RcuSnapshot<ConnectionMap> active_connections_;             // 所有活动连接，写操作在 conn_mutex_ 下进行
+    SubscriberRouter router_;                   // 订阅者路由表
+    SubscriberRouter::FlowCache flows_;         // 仅接收线程访问
+    std::shared_ptr<BufferPool> recv_pool_;     // 接收缓冲池（start 时按配置创建）
+#ifdef IO_URING_MODE
+    int wakeup_fd_ = -1;                        // eventfd，新连接/停止时唤醒接收线程
+    std::atomic<bool> uring_receiving_{false};  // 接收线程正运行io_uring循环
+#endif
 };
 
 #ifdef THREAD_POOL_MODE
@@ -847,9 +1150,15 @@ int TcpCommunicateCore::initialize()
     m_config.source_addr.source_port = cfg.getValue("source_port", 0);
     m_config.source_addr.source_ip = cfg.getValue("source_ip", (std::string)"");
     m_config.thread_pool_size = cfg.getValue("thread_pool_size", 3);
+    m_config.thread_pool_scheduler = cfg.getValue("thread_pool_scheduler", (std::string) "queue");
     m_config.max_connections = cfg.getValue("max_connections", 100);
     m_config.listen_backlog = cfg.getValue("listen_backlog", 10);
     m_config.keepalive_time = cfg.getValue("keepalive", 60);
+    m_config.recv_pool_size = cfg.getValue("recv_pool_size", 256);
+    m_config.io_backend = cfg.getValue("io_backend", (std::string)"poll");
+    m_config.uring_entries = cfg.getValue("uring_entries", 256);
+    m_config.uring_buf_count = cfg.getValue("uring_buf_count", 256);
+    m_config.zerocopy_threshold = cfg.getValue("zerocopy_threshold", 16384);
 
     LOG_DEBUG("Configuration loaded - max_send: {}, send_timeout: {}ms, recv_timeout: {}ms, connect_timeout: {}ms, source_addr: {}:{}, thread_pool: {}",
               m_config.max_send_packet_size,
@@ -857,8 +1166,14 @@ int TcpCommunicateCore::initialize()
               m_config.source_addr.source_ip, m_config.source_addr.source_port,
               m_config.thread_pool_size);
 #ifdef THREAD_POOL_MODE
-    s_thread_pool_ = std::make_unique<ThreadPoolWrapper>(m_config.thread_pool_size);
-    LOG_DEBUG("Created thread pool with size: {}", m_config.thread_pool_size);
+    s_thread_pool_ = std::make_unique<ThreadPoolWrapper>(m_config.thread_pool_size, 1024,
+        m_config.thread_pool_scheduler == "work_stealing" ? ThreadPoolWrapper::Scheduler::WorkStealing
+                                                          : ThreadPoolWrapper::Scheduler::GlobalQueue);
+    LOG_DEBUG("Created thread pool with size: {}, scheduler: {}", m_config.thread_pool_size, m_config.thread_pool_scheduler);
+#endif
+#ifndef IO_URING_MODE
+    if (m_config.io_backend == "io_uring")
+        LOG_WARNING("io_backend io_uring requested but library built without IO_URING_MODE, using poll");
 #endif
 
     // 加载监听地址列表
@@ -895,6 +1210,32 @@ bool TcpCommunicateCore::send(const std::string &dest_addr, int dest_port,
     return pimpl_->sendData(dest_addr, dest_port, data, size);
 }
 
+bool TcpCommunicateCore::sendv(const std::string &dest_addr, int dest_port,
+                               const communicate::iovec *iov, int iovcnt)
+{
+    return pimpl_->sendDataV(dest_addr, dest_port, iov, iovcnt);
+}
+
+bool TcpCommunicateCore::sendOwned(const std::string &dest_addr, int dest_port,
+                                   std::shared_ptr<const void> data, size_t size)
+{
+    return pimpl_->sendData(dest_addr, dest_port, data.get(), size, data);
+}
+
+std::shared_ptr<const CommunicateInterface::EndpointHandle> TcpCommunicateCore::resolveEndpoint(
+    const std::string &addr, int port)
+{
+    in_addr ip = {};
+    if (inet_pton(AF_INET, addr.c_str(), &ip) != 1)
+    {
+        LOG_ERROR("Invalid destination address: {}", addr);
+        return nullptr;
+    }
+    if (!pimpl_->connectToServer(addr, port))
+        LOG_WARNING("Failed to connect to {}:{}, will retry on send", addr, port);
+    return CommunicateInterface::resolveEndpoint(addr, port);
+}
+
 int TcpCommunicateCore::addListenAddr(const char *addr, int port)
 {
     std::string addr_str(addr ? addr : "");
@@ -911,9 +1252,8 @@ int TcpCommunicateCore::addSubscribe(const char *addr, int port,
                                      communicate::SubscribebBase *sub)
 {
     std::string addr_str(addr ? addr : "");
-    std::string key = TcpCommunicateCore::Impl::createSubKey(addr_str, port);
-    LOG_DEBUG("Adding subscriber for key: {}", key);
-    pimpl_->addSubscriber(key, sub);
+    if (!pimpl_->addSubscriber(addr_str, port, sub))
+        return -1;
     pimpl_->start();
     return 0;
 }
@@ -16,7 +16,10 @@ Version history
 #define TCP_CORE_H_  
   
 #include "../communicate_interface.h"
+#include "../subscriber_router.h"
+#include "../zerocopy_tracker.h"
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -24,6 +27,7 @@ Version history
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector> 
 
 #ifdef _WIN32
@@ -46,7 +50,13 @@ Version history
 #ifdef THREAD_POOL_MODE
 #include "threadpool_wrapper.h"
 #endif
+#ifdef IO_URING_MODE
+#include <sys/eventfd.h>
+#include "uring_engine.h"
+#endif
 #include "common/config_wrapper.h"
+#include "utils/buffer_pool.h"
+#include "utils/rcu_snapshot.h"
   
 class TcpCommunicateCore : public CommunicateInterface  
 {  
@@ -61,6 +71,12 @@ public:
     int initialize() override;
     // 发送会优先使用已经建立连接的源，后文 setDefSource 不会影响
     bool send(const std::string& dest_addr, int dest_port, const void* data, size_t size) override;  
+    // 多段数据按拼接后的整体分片，经 sendmsg 直接发送各段（Windows 先拼接）
+    bool sendv(const std::string &dest_addr, int dest_port, const communicate::iovec *iov, int iovcnt) override;
+    // 超过 zerocopy_threshold 时以 MSG_ZEROCOPY 发送，data 保持至内核完成通知
+    bool sendOwned(const std::string &dest_addr, int dest_port, std::shared_ptr<const void> data, size_t size) override;
+    // 校验地址并预先建立连接，发送仍按地址查找连接
+    std::shared_ptr<const EndpointHandle> resolveEndpoint(const std::string &addr, int port) override;
     int addListenAddr(const char* addr, int port) override;  
     int addSubscribe(const char* addr, int port, communicate::SubscribebBase *sub) override;  
     void shutdown() override;
@@ -77,9 +93,15 @@ protected:
         int max_send_packet_size = 1460;// 单个数据包最大大小（以太网MTU 1500 - TCP/IP头40
         LocalSourceAddr source_addr;    // 建立连接优先使用本地地址，port 0为端口系统自动分配 ip 空为默认网卡
         int thread_pool_size = 3;  
+        std::string thread_pool_scheduler = "queue";    // 线程池调度方式：queue / work_stealing，需THREAD_POOL_MODE编译
         int max_connections = 100;      // TCP特有：最大并发连接数（防资源耗尽）
         int listen_backlog = 10;        // TCP特有：监听队列长度
         int keepalive_time = 60;        // 保活机制，设置 0 为不启用保活机制
+        int recv_pool_size = 256;       // 接收缓冲池最多缓存的空闲缓冲数（每个缓冲 max_send_packet_size 字节）
+        std::string io_backend = "poll";// 接收后端：poll / io_uring（需IO_URING_MODE编译，内核不支持时自动回退）
+        int uring_entries = 256;        // io_uring 提交队列深度
+        int uring_buf_count = 256;      // io_uring 接收提供缓冲数量（2的幂，每个缓冲 max_send_packet_size 字节）
+        int zerocopy_threshold = 16384; // 转移所有权发送的数据不小于该值时使用 MSG_ZEROCOPY（仅Linux），0 为不启用
     } m_config;
 
 #ifdef THREAD_POOL_MODE
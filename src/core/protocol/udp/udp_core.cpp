@@ -1,16 +1,53 @@
 #include "udp_core.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <iostream>
 #include <functional>
 #include <future>
+#include <list>
 
 #ifdef _WIN32
 #pragma comment(lib, "ws2_32.lib")
+using communicate::iovec;
+#endif
+
+#ifdef DUAL_ENDPOINT_MODE
+#include "utils/fragment_reassembler.h"
 #endif
 
 class UdpCommunicateCore::Impl
 {
+    // 使用RAII管理临时socket
+    struct SocketGuard
+    {
+        SocketType fd;
+        ~SocketGuard()
+        {
+            if (fd == INVALID_SOCKET)
+                return;
+#ifdef _WIN32
+            closesocket(fd);
+#else
+            close(fd);
+#endif
+        }
+    };
+
+    // 发送socket及目标地址（发送接口以此为参数，需先于其声明）
+    struct SendConn
+    {
+        SocketType fd = INVALID_SOCKET;
+        sockaddr_in dest_addr = {};         // 预先解析的目标地址
+        std::shared_ptr<std::mutex> send_mutex;     // 多数据报消息的发送锁（连接池socket共享，临时socket无）
+        std::shared_ptr<SocketGuard> closer;        // 移出连接池/缓存后由最后一个使用者关闭（临时socket无）
+        bool pooled = false;                        // 连接池socket，彼此可互换发送
+#ifdef __linux__
+        std::shared_ptr<ZeroCopyTracker> zerocopy;  // 零拷贝发送的完成跟踪（临时socket无）
+#endif
+    };
+
 public:
     Impl(CoreConfig &config) : is_running_(false), config_(config)
     {
@@ -22,6 +59,8 @@ public:
         else
             LOG_DEBUG("WSAStartup successful");
 #endif
+        // 默认单个接收分片，initialize 中按配置扩展
+        shards_.push_back(createShard(0));
     }
 
     ~Impl()
@@ -40,8 +79,24 @@ public:
         LOG_TRACE("Start listening for UDP messages");
         if (!is_running_.exchange(true))
         {
-            LOG_INFO("Starting UDP receiver thread");
-            receiver_thread_ = std::thread(&Impl::receiverLoop, this);
+            // 接收缓冲由内核直接写入后交给订阅者，缓冲大小需容纳最大数据报
+            size_t block_size = config_.max_receive_packet_size;
+#ifdef __linux__
+            // GRO 合并后的数据最长为64KB
+            if (config_.udp_gro)
+                block_size = std::max<size_t>(block_size, UINT16_MAX);
+#endif
+#ifdef IO_URING_MODE
+            // multishot recvmsg 在数据前写入头部、发送方地址与控制数据
+            block_size += sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in) + sizeof(RecvControl);
+#endif
+            recv_pool_ = BufferPool::create(block_size, config_.recv_pool_size);
+
+            LOG_INFO("Starting {} UDP receiver thread(s)", shards_.size());
+            for (auto &shard : shards_)
+            {
+                shard->thread = std::thread(&Impl::receiverLoop, this, shard.get());
+            }
         }
     }
 
@@ -50,11 +105,18 @@ public:
         LOG_TRACE("Stop listening for UDP messages");
         if (is_running_.exchange(false))
         {
-            LOG_INFO("Stopping UDP receiver thread");
-            if (receiver_thread_.joinable())
+            LOG_INFO("Stopping UDP receiver threads");
+#ifdef __linux__
+            // 唤醒阻塞在epoll_wait上的接收线程
+            wakeupReceiver();
+#endif
+            for (auto &shard : shards_)
             {
-                receiver_thread_.join();
-                LOG_DEBUG("Receiver thread joined");
+                if (shard->thread.joinable())
+                {
+                    shard->thread.join();
+                    LOG_DEBUG("Receiver thread {} joined", shard->index);
+                }
             }
             closeAllSockets();
         }
@@ -67,7 +129,8 @@ public:
         std::lock_guard<std::mutex> lock(socket_mutex_);
 
         // 检查是否已存在该地址的监听
-        for (const auto &sock : sockets_)
+        auto sockets = sockets_.read();
+        for (const auto &sock : *sockets)
         {
             if (sock.addr_port == key)
             {
@@ -76,18 +139,136 @@ public:
             }
         }
 
-        SocketType sockfd = createAndBindSocket(addr, port);
-        if (sockfd == INVALID_SOCKET)
+        // 多分片时每个分片各打开一个 SO_REUSEPORT socket，由内核在分片间分配数据包
+        const size_t shard_count = shards_.size();
+        std::vector<SocketType> fds;
+        int bind_port = port;
+        for (size_t i = 0; i < shard_count; ++i)
         {
-            LOG_ERROR("Failed to create/bind listen socket for {}:{}", addr, port);
-            return false;
+            SocketType sockfd = createAndBindSocket(addr, bind_port, shard_count > 1);
+            if (sockfd == INVALID_SOCKET)
+            {
+                LOG_ERROR("Failed to create/bind listen socket for {}:{}", addr, bind_port);
+                for (SocketType fd : fds)
+                {
+#ifdef _WIN32
+                    closesocket(fd);
+#else
+                    close(fd);
+#endif
+                }
+                return false;
+            }
+            fds.push_back(sockfd);
+
+            // 端口由系统分配时，其余分片需绑定到同一端口
+            sockaddr_in local_addr = {};
+            if (bind_port == 0 && getLocalAddr(sockfd, local_addr))
+                bind_port = ntohs(local_addr.sin_port);
         }
 
-        sockets_.push_back({sockfd, key});
-        LOG_INFO("Added listening socket for {}:{}", addr, port);
+#ifdef __linux__
+        if (shard_count > 1 && config_.reuseport_cpu_steering)
+            attachCpuSteering(fds[0], shard_count);
+
+        for (size_t i = 0; i < shard_count; ++i)
+        {
+            epoll_event ev = {};
+            ev.events = EPOLLIN;
+            ev.data.u64 = epollTag(fds[i], static_cast<uint16_t>(bind_port));
+            if (epoll_ctl(shards_[i]->epoll_fd, EPOLL_CTL_ADD, fds[i], &ev) < 0)
+            {
+                LOG_ERROR("Failed to register listen socket {}:{} to epoll - {}", addr, port, strerror(errno));
+                for (SocketType fd : fds)
+                    close(fd);
+                return false;
+            }
+        }
+#endif
+
+        sockets_.update([&](std::vector<ListeningSocket> &sockets) {
+            for (size_t i = 0; i < shard_count; ++i)
+            {
+                sockets.push_back({fds[i], key, static_cast<uint16_t>(bind_port), i});
+            }
+        });
+#ifdef IO_URING_MODE
+        // io_uring 接收循环需被唤醒以挂载新socket的接收请求
+        if (is_running_.load())
+            wakeupReceiver();
+#endif
+        LOG_INFO("Added listening socket for {}:{} ({} shard(s))", addr, port, shard_count);
         return true;
     }
 
+    // 设置接收分片（线程）数，需在添加监听地址前调用
+    void setRecvShards(int count)
+    {
+        if (count < 1)
+            count = 1;
+#ifndef __linux__
+        if (count > 1)
+        {
+            LOG_WARNING("Multi-threaded receive sharding requires SO_REUSEPORT on Linux, using 1 thread");
+            count = 1;
+        }
+#endif
+        std::lock_guard<std::mutex> lock(socket_mutex_);
+        if (is_running_.load() || !sockets_.read()->empty())
+        {
+            LOG_WARNING("Receive shards can only be changed before listening starts");
+            return;
+        }
+        while (shards_.size() < static_cast<size_t>(count))
+        {
+            shards_.push_back(createShard(shards_.size()));
+        }
+        shards_.resize(count);
+    }
+
+#ifdef __linux__
+    void wakeupReceiver()
+    {
+        uint64_t one = 1;
+        for (auto &shard : shards_)
+        {
+            if (write(shard->wakeup_fd, &one, sizeof(one)) != sizeof(one))
+                LOG_WARNING("Failed to wake up receiver thread {}: {}", shard->index, strerror(errno));
+        }
+    }
+
+    // 按处理数据包的CPU号选择 reuseport 组内的socket（组内序号即绑定顺序）
+    static void attachCpuSteering(SocketType sockfd, size_t shard_count)
+    {
+        sock_filter code[] = {
+            {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+            {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(shard_count)},
+            {BPF_RET | BPF_A, 0, 0, 0},
+        };
+        sock_fprog prog = {};
+        prog.len = sizeof(code) / sizeof(code[0]);
+        prog.filter = code;
+        if (setsockopt(sockfd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0)
+            LOG_WARNING("Failed to attach reuseport CPU steering filter: {}", strerror(errno));
+    }
+#endif
+
+#ifdef IO_URING_MODE
+    // 发送使用的io_uring实例（在send_ring_mutex_保护下使用），初始化失败时保持sendmmsg发送
+    void initUringSend()
+    {
+        auto ring = std::make_unique<UringEngine>();
+        if (!ring->init(config_.uring_entries))
+        {
+            LOG_WARNING("io_uring send unavailable ({}), falling back to sendmmsg", strerror(errno));
+            return;
+        }
+        std::lock_guard<std::mutex> lock(send_ring_mutex_);
+        send_ring_ = std::move(ring);
+        LOG_INFO("UDP send using io_uring backend");
+    }
+#endif
+
     bool addSendConnSocket(const std::string &addr, int port)
     {
         std::string key = addr + ":" + std::to_string(port);
@@ -95,128 +276,743 @@ public:
         std::lock_guard<std::mutex> lock(socket_mutex_);
 
         // 检查是否已存在该目标地址的连接
-        if (conn_pool_.find(key) != conn_pool_.end())
+        if (conn_pool_.read()->count(key))
         {
             LOG_WARNING("Target addr_key {} is already in the connection pool", key);
             return true;
         }
 
-        SocketType sockfd = createSendSocket(addr, port);
-        if (sockfd == INVALID_SOCKET)
+        // 目标地址只解析一次，后续发送直接使用
+        SendConn conn;
+        if (!resolveAddr(addr, port, conn.dest_addr))
+        {
+            LOG_ERROR("Invalid destination address: {}", addr);
+            return false;
+        }
+
+        conn.fd = createSendSocket(addr, port);
+        if (conn.fd == INVALID_SOCKET)
         {
             LOG_ERROR("Failed to create/bind send socket for {}:{}", addr, port);
             return false;
         }
+        conn.closer.reset(new SocketGuard{conn.fd});
+        conn.pooled = true;
+        conn.send_mutex = std::make_shared<std::mutex>();
+#ifdef __linux__
+        conn.zerocopy = std::make_shared<ZeroCopyTracker>(conn.fd);
+#endif
 
-        conn_pool_[key] = sockfd;
+        conn_pool_.update([&](ConnPool &pool) { pool[key] = conn; });
         LOG_INFO("Added send socket for {}:{}", addr, port);
         return true;
     }
 
-    // 带连接池支持的发送方法
+    // 带连接池支持的发送方法，owner 非空表示调用方已转移数据所有权，大块数据可使用零拷贝发送
     bool sendDataWithPool(const std::string &dest_addr, int dest_port,
-                          const void *data, size_t size)
+                          const void *data, size_t size, const std::shared_ptr<const void> &owner = nullptr)
     {
-        LOG_TRACE("Attempting to send {} bytes to {}:{} (with connection pool)",
-                  size, dest_addr, dest_port);
+        iovec iov = {const_cast<void *>(data), size};
+        return sendvWithPool(dest_addr, dest_port, &iov, 1, owner);
+    }
 
-        SocketType sockfd = getConnection(dest_addr, dest_port);
-        if (sockfd == INVALID_SOCKET)
+    bool sendvWithPool(const std::string &dest_addr, int dest_port, const iovec *iov, size_t iovcnt,
+                       const std::shared_ptr<const void> &owner = nullptr)
+    {
+        LOG_TRACE("Attempting to send {} buffers to {}:{} (with connection pool)",
+                  iovcnt, dest_addr, dest_port);
+
+        SendConn conn = getConnection(dest_addr, dest_port);
+        if (conn.fd == INVALID_SOCKET && config_.send_cache_size > 0)
+        {
+            conn = getCachedConnection(dest_addr, dest_port);
+            if (conn.fd == INVALID_SOCKET)
+                return false;
+        }
+        else if (conn.fd == INVALID_SOCKET)
         {
             LOG_WARNING("Failed to get/create connection, creating temp socket");
-            sockfd = createSendSocket(dest_addr, dest_port);
-            if (sockfd == INVALID_SOCKET)
+            if (!resolveAddr(dest_addr, dest_port, conn.dest_addr))
+            {
+                LOG_ERROR("Invalid destination address: {}", dest_addr);
+                return false;
+            }
+            conn.fd = createSendSocket(dest_addr, dest_port);
+            if (conn.fd == INVALID_SOCKET)
                 return false;
 
-            // 使用RAII管理临时socket
-            struct SocketGuard
+            // 临时socket仅本次使用：无需发送锁，发送后立即关闭也无法等待零拷贝完成通知
+            SocketGuard guard{conn.fd};
+            return doSendV(conn, iov, iovcnt);
+        }
+
+        return doSendV(conn, iov, iovcnt, owner);
+    }
+
+    // 预解析的发送目标：连接池中的目标共用池中socket，其余目标独占一个socket
+    // 句柄持有socket的引用，连接池清空（Destroy）后socket仍保持打开，直到最后一个句柄副本释放
+    struct UdpEndpoint : EndpointHandle
+    {
+        SendConn conn;
+    };
+
+    std::shared_ptr<const EndpointHandle> resolveEndpoint(const std::string &addr, int port)
+    {
+        auto endpoint = std::make_shared<UdpEndpoint>();
+        endpoint->addr = addr;
+        endpoint->port = port;
+        endpoint->conn = getConnection(addr, port);
+        if (endpoint->conn.fd != INVALID_SOCKET)
+            return endpoint;
+
+        SendConn &conn = endpoint->conn;
+        if (!resolveAddr(addr, port, conn.dest_addr))
+        {
+            LOG_ERROR("Invalid destination address: {}", addr);
+            return nullptr;
+        }
+        conn.fd = createSendSocket(addr, port);
+        if (conn.fd == INVALID_SOCKET)
+            return nullptr;
+        conn.closer.reset(new SocketGuard{conn.fd});
+        conn.send_mutex = std::make_shared<std::mutex>();
+        LOG_DEBUG("Resolved endpoint {}:{} with dedicated send socket", addr, port);
+        return endpoint;
+    }
+
+    bool sendToEndpoint(const EndpointHandle &endpoint, const void *data, size_t size,
+                        const std::shared_ptr<const void> &owner = nullptr)
+    {
+        auto *udp_endpoint = dynamic_cast<const UdpEndpoint *>(&endpoint);
+        if (!udp_endpoint)
+            return sendDataWithPool(endpoint.addr, endpoint.port, data, size, owner);
+
+        const SendConn &conn = udp_endpoint->conn;
+        if (size > static_cast<size_t>(config_.max_send_packet_size) || config_.udp_fragment)
+            return doSend(conn, data, size, owner);
+
+        // 单个数据报直接发出：无需分片、加锁或临时分配
+        ssize_t sent_bytes = sendto(conn.fd, reinterpret_cast<const char *>(data), static_cast<int>(size), 0,
+                                    reinterpret_cast<const sockaddr *>(&conn.dest_addr), sizeof(sockaddr_in));
+        if (sent_bytes != static_cast<ssize_t>(size))
+        {
+            LOG_ERROR("Failed to send {} bytes to {}:{} - {}", size, endpoint.addr, endpoint.port, strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+    // 多条消息一并发出：单个数据报的消息按发送socket分组后由 sendmmsg 批量发送，其余逐条经 sendToEndpoint
+    // 连接池中的socket可互换（见 sendBatchWithPool），发往池中目标的消息共用一组
+    int sendBurst(const std::vector<OutgoingMessage> &messages, std::vector<bool> *results)
+    {
+        std::vector<bool> ok(messages.size(), false);
+#ifdef __linux__
+        struct Group
+        {
+            SocketType fd;
+            std::vector<size_t> index;      // messages 下标
+        };
+        std::vector<Group> groups;
+        SocketType pooled_fd = INVALID_SOCKET;
+#endif
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            const OutgoingMessage &message = messages[i];
+#ifdef __linux__
+            auto *udp_endpoint = dynamic_cast<const UdpEndpoint *>(message.endpoint);
+            if (udp_endpoint && message.size <= static_cast<size_t>(config_.max_send_packet_size) &&
+                !config_.udp_fragment)
             {
-                SocketType fd;
-                ~SocketGuard()
+                SocketType fd = udp_endpoint->conn.fd;
+                if (udp_endpoint->conn.pooled)
                 {
-#ifdef _WIN32
-                    closesocket(fd);
-#else
-                    close(fd);
+                    if (pooled_fd == INVALID_SOCKET)
+                        pooled_fd = fd;
+                    fd = pooled_fd;
+                }
+                auto group = std::find_if(groups.begin(), groups.end(), [fd](const Group &g) { return g.fd == fd; });
+                if (group == groups.end())
+                    group = groups.insert(groups.end(), Group{fd, {}});
+                group->index.push_back(i);
+                continue;
+            }
 #endif
+            ok[i] = sendToEndpoint(*message.endpoint, message.data, message.size);
+        }
+
+#ifdef __linux__
+        std::vector<mmsghdr> msgs;
+        std::vector<iovec> iovs;
+        for (const Group &group : groups)
+        {
+            const size_t total = group.index.size();
+            msgs.assign(total, mmsghdr{});
+            iovs.resize(total);
+            for (size_t j = 0; j < total; ++j)
+            {
+                const OutgoingMessage &message = messages[group.index[j]];
+                auto *udp_endpoint = static_cast<const UdpEndpoint *>(message.endpoint);
+                iovs[j] = {const_cast<void *>(message.data), message.size};
+                msghdr &hdr = msgs[j].msg_hdr;
+                hdr.msg_name = const_cast<sockaddr_in *>(&udp_endpoint->conn.dest_addr);
+                hdr.msg_namelen = sizeof(sockaddr_in);
+                hdr.msg_iov = &iovs[j];
+                hdr.msg_iovlen = 1;
+            }
+
+            size_t next = 0;
+            while (next < total)
+            {
+                int sent = sendmmsg(group.fd, msgs.data() + next, static_cast<unsigned int>(total - next), 0);
+                if (sent < 0)
+                {
+                    // 首条消息发送失败：记录失败并跳过这一条，继续发送其余消息
+                    const EndpointHandle *endpoint = messages[group.index[next]].endpoint;
+                    LOG_ERROR("Failed to send {} bytes to {}:{} - {}", iovs[next].iov_len,
+                              endpoint->addr, endpoint->port, strerror(errno));
+                    ++next;
+                    continue;
                 }
-            } guard{sockfd};
+                for (int k = 0; k < sent; ++k, ++next)
+                    ok[group.index[next]] = msgs[next].msg_len == iovs[next].iov_len;
+            }
+        }
+#endif
+
+        if (results)
+            *results = ok;
+        return static_cast<int>(std::count(ok.begin(), ok.end(), false));
+    }
+
+    // 同一份数据发往多个目标，所有目标和分片在一次加锁内批量发出
+    int sendBatchWithPool(const std::vector<std::pair<std::string, int>> &dest_list,
+                          const void *data, size_t size, std::vector<bool> *results)
+    {
+        LOG_TRACE("Attempting to send {} bytes to {} targets (with connection pool)",
+                  size, dest_list.size());
 
-            return doSend(sockfd, dest_addr, dest_port, data, size);
+        if (results)
+            results->assign(dest_list.size(), false);
+
+        std::vector<sockaddr_in> dests;
+        std::vector<size_t> dest_index;     // dests 下标 -> dest_list 下标
+        dests.reserve(dest_list.size());
+        dest_index.reserve(dest_list.size());
+        int failed = 0;
+
+        // 池中的发送socket均未connect且源地址配置一致，可用其中任意一个发往所有目标
+        SendConn sender;
+        {
+            auto pool = conn_pool_.read();
+            for (size_t i = 0; i < dest_list.size(); ++i)
+            {
+                const auto &[addr, port] = dest_list[i];
+                auto it = pool->find(addr + ":" + std::to_string(port));
+                sockaddr_in dest_addr_in = {};
+                if (it != pool->end())
+                {
+                    dest_addr_in = it->second.dest_addr;
+                    if (sender.fd == INVALID_SOCKET)
+                        sender = it->second;
+                }
+                else if (!resolveAddr(addr, port, dest_addr_in))
+                {
+                    LOG_ERROR("Invalid destination address: {}", addr);
+                    ++failed;
+                    continue;
+                }
+                dests.push_back(dest_addr_in);
+                dest_index.push_back(i);
+            }
         }
 
-        return doSend(sockfd, dest_addr, dest_port, data, size);
+        if (dests.empty())
+            return failed;
+
+        std::vector<bool> dest_results;
+        SocketGuard guard{INVALID_SOCKET};
+        if (sender.fd == INVALID_SOCKET && config_.send_cache_size > 0)
+        {
+            sender = getCachedConnection(dest_list[dest_index[0]].first, dest_list[dest_index[0]].second);
+            if (sender.fd == INVALID_SOCKET)
+                return failed + static_cast<int>(dests.size());
+        }
+        else if (sender.fd == INVALID_SOCKET)
+        {
+            LOG_WARNING("No pooled socket for targets, creating temp socket");
+            sender.fd = guard.fd = createSendSocket(dest_list[dest_index[0]].first, dest_list[dest_index[0]].second);
+            if (sender.fd == INVALID_SOCKET)
+                return failed + static_cast<int>(dests.size());
+        }
+
+        iovec iov = {const_cast<void *>(data), size};
+        failed += doSendTo(sender, dests.data(), dests.size(), &iov, 1, size, dest_results);
+
+        for (size_t i = 0; i < dest_results.size(); ++i)
+        {
+            const auto &[addr, port] = dest_list[dest_index[i]];
+            if (!dest_results[i])
+                LOG_ERROR("Failed to send complete message to {}:{}", addr, port);
+            if (results)
+                (*results)[dest_index[i]] = dest_results[i];
+        }
+        return failed;
     }
 
-    // 实际发送逻辑（复用原有代码）
-    bool doSend(SocketType sockfd, const std::string &dest_addr, int dest_port,
-                const void *data, size_t size)
+    bool doSend(const SendConn &conn, const void *data, size_t size,
+                const std::shared_ptr<const void> &owner = nullptr)
     {
-        sockaddr_in dest_addr_in = {};
-        dest_addr_in.sin_family = AF_INET;
-        dest_addr_in.sin_port = htons(dest_port);
+        iovec iov = {const_cast<void *>(data), size};
+        return doSendV(conn, &iov, 1, owner);
+    }
 
-        if (inet_pton(AF_INET, dest_addr.c_str(), &dest_addr_in.sin_addr) <= 0)
+    // 多段数据视为一条连续消息发送
+    bool doSendV(const SendConn &conn, const iovec *iov, size_t iovcnt,
+                 const std::shared_ptr<const void> &owner = nullptr)
+    {
+        size_t size = 0;
+        for (size_t i = 0; i < iovcnt; ++i)
         {
-            LOG_ERROR("Invalid destination address: {}", dest_addr);
-            return false;
+            size += iov[i].iov_len;
+        }
+        const sockaddr_in &dest_addr_in = conn.dest_addr;
+        std::vector<bool> results;
+        bool success = doSendTo(conn, &dest_addr_in, 1, iov, iovcnt, size, results, owner) == 0;
+
+        char dest_ip[INET_ADDRSTRLEN] = {0};
+        inet_ntop(AF_INET, &dest_addr_in.sin_addr, dest_ip, INET_ADDRSTRLEN);
+        if (success)
+            LOG_DEBUG("Successfully sent {} bytes to {}:{}", size, dest_ip, ntohs(dest_addr_in.sin_port));
+        else
+            LOG_ERROR("Failed to send complete message to {}:{}", dest_ip, ntohs(dest_addr_in.sin_port));
+        return success;
+    }
+
+    // 实际发送逻辑：iov 拼接后的 size 字节数据按 max_send_packet_size 分片发往每个目标，分片可跨越 iovec 边界
+    // results 记录各目标是否完整发送，返回失败目标数
+    // owner 非空且数据不小于 zerocopy_threshold 时以 MSG_ZEROCOPY 发送（仅 GSO 消息），owner 由跟踪器持有至完成通知
+    // 同一socket上的发送默认并行；一条消息需拆成多个数据报发给同一目标时才持有该socket的发送锁，避免与其他消息交错
+    int doSendTo(const SendConn &conn, const sockaddr_in *dests, size_t dest_count,
+                 const iovec *iov, size_t iovcnt, size_t size, std::vector<bool> &results,
+                 std::shared_ptr<const void> owner = nullptr)
+    {
+        results.assign(dest_count, true);
+        const SocketType sockfd = conn.fd;
+        const size_t packet_size = static_cast<size_t>(config_.max_send_packet_size);
+        std::unique_lock<std::mutex> socket_lock;
+
+#ifdef DUAL_ENDPOINT_MODE
+        // 分片模式：每 packet_size 字节的数据报以分片头开始，后续按 packet_size 的切分（含GSO）恰好落在分片边界
+        FragmentFramer::Frames frames;
+        if (config_.udp_fragment)
+        {
+            if (!FragmentFramer::frame(iov, iovcnt, size, packet_size,
+                                       next_msg_id_.fetch_add(1, std::memory_order_relaxed),
+                                       fragment_checksum_, frames))
+            {
+                LOG_ERROR("Cannot fragment {} bytes with max_send_packet_size {}", size, packet_size);
+                results.assign(dest_count, false);
+                return static_cast<int>(dest_count);
+            }
+            iov = frames.iov.data();
+            iovcnt = frames.iov.size();
+            size = frames.size;
+            // 分片头与数据交错后单条 GSO 报文引用的页数超出内核零拷贝上限（EMSGSIZE），分片模式下不使用零拷贝
+            owner = nullptr;
         }
-        // 分片发送逻辑
-        const char *data_ptr = reinterpret_cast<const char *>(data);
-        size_t remaining = size;
-        bool success = true;
+#endif
 
-        std::lock_guard<std::mutex> lock(send_mutex_); // 添加发送互斥锁
+#ifdef __linux__
+        // 多个分片时优先使用 GSO：每个目标的数据整段交给内核，由内核按 packet_size 切分
+        size_t segments = (size > packet_size && gso_enabled_.load(std::memory_order_relaxed))
+                              ? gsoSegments(packet_size) : 1;
+        if (conn.send_mutex && size > packet_size * segments)
+            socket_lock = std::unique_lock<std::mutex>(*conn.send_mutex);
+
+        // 零拷贝发送与序号登记须在跟踪器锁内完成（加锁顺序：socket发送锁 -> 跟踪器锁）
+        ZeroCopyTracker *zerocopy = nullptr;
+        std::unique_lock<std::mutex> zerocopy_lock;
+        if (owner && conn.zerocopy && segments > 1 && config_.zerocopy_threshold > 0 &&
+            size >= static_cast<size_t>(config_.zerocopy_threshold))
+        {
+            zerocopy_lock = std::unique_lock<std::mutex>(conn.zerocopy->mutex());
+            bool usable = conn.zerocopy->usable();
+            if (conn.zerocopy->takeCopiedNotice())
+                LOG_INFO("Kernel copied zerocopy sends on socket {}, using regular send", sockfd);
+            if (usable)
+                zerocopy = conn.zerocopy.get();
+            else
+                zerocopy_lock.unlock();
+        }
 
-        while (remaining > 0)
+        if (segments > 1 &&
+            !sendSegments(sockfd, dests, dest_count, iov, iovcnt, size, segments, results, zerocopy, owner))
         {
-            size_t chunk_size = (remaining > config_.max_send_packet_size) ? config_.max_send_packet_size : remaining;
+            // 内核或网卡拒绝 GSO（如出口MTU小于分片大小、网卡不支持校验和卸载），此后逐分片发送
+            LOG_WARNING("UDP GSO rejected ({}), falling back to per-chunk send", strerror(errno));
+            gso_enabled_.store(false, std::memory_order_relaxed);
+            results.assign(dest_count, true);
+            segments = 1;
+            if (zerocopy_lock.owns_lock())
+                zerocopy_lock.unlock();
+            if (conn.send_mutex && !socket_lock.owns_lock())
+                socket_lock = std::unique_lock<std::mutex>(*conn.send_mutex);
+        }
+        if (segments == 1)
+            sendSegments(sockfd, dests, dest_count, iov, iovcnt, size, 1, results);
+#else
+        if (conn.send_mutex && size > packet_size)
+            socket_lock = std::unique_lock<std::mutex>(*conn.send_mutex);
 
-            ssize_t sent_bytes = sendto(
-                sockfd,
-                data_ptr,
-                static_cast<int>(chunk_size),
-                0,
-                reinterpret_cast<const sockaddr *>(&dest_addr_in),
-                sizeof(dest_addr_in));
+        // 多段数据先拼接为连续缓冲
+        std::vector<char> joined;
+        const char *data_ptr = reinterpret_cast<const char *>(iov[0].iov_base);
+        if (iovcnt > 1)
+        {
+            joined.reserve(size);
+            for (size_t i = 0; i < iovcnt; ++i)
+            {
+                const char *base = reinterpret_cast<const char *>(iov[i].iov_base);
+                joined.insert(joined.end(), base, base + iov[i].iov_len);
+            }
+            data_ptr = joined.data();
+        }
 
-            if (sent_bytes != static_cast<ssize_t>(chunk_size))
+        // 分片只与数据有关，所有目标共用
+        for (size_t d = 0; d < dest_count; ++d)
+        {
+            for (size_t offset = 0; offset < size; offset += packet_size)
             {
-                LOG_ERROR("Failed to send complete chunk (sent {} of {} bytes)",
-                          sent_bytes, chunk_size);
-                success = false;
-                break;
+                size_t chunk_size = std::min(packet_size, size - offset);
+                ssize_t sent_bytes = sendto(
+                    sockfd,
+                    data_ptr + offset,
+                    static_cast<int>(chunk_size),
+                    0,
+                    reinterpret_cast<const sockaddr *>(&dests[d]),
+                    sizeof(sockaddr_in));
+
+                if (sent_bytes != static_cast<ssize_t>(chunk_size))
+                {
+                    LOG_ERROR("Failed to send complete chunk (sent {} of {} bytes)",
+                              sent_bytes, chunk_size);
+                    results[d] = false;
+                    break;
+                }
             }
-            data_ptr += sent_bytes;
-            remaining -= sent_bytes;
         }
+#endif
 
-        if (success)
-            LOG_DEBUG("Successfully sent {} bytes to {}:{}", size, dest_addr, dest_port);
+        return static_cast<int>(std::count(results.begin(), results.end(), false));
+    }
+
+#ifdef __linux__
+    // 单次 GSO 发送的分片数：受内核 UDP_MAX_SEGMENTS 与单个 UDP 报文长度上限约束
+    static size_t gsoSegments(size_t packet_size)
+    {
+        constexpr size_t UDP_MAX_SEGMENTS = 64;     // 早期内核的上限（新内核为128）
+        constexpr size_t UDP_MAX_PAYLOAD = 65507;   // 65535 - IP/UDP 头
+        return std::max<size_t>(1, std::min(UDP_MAX_SEGMENTS, UDP_MAX_PAYLOAD / packet_size));
+    }
+
+    // 每条消息携带 segments 个分片（>1 时附带 UDP_SEGMENT 控制数据），所有目标的所有消息由 sendmmsg 批量发出
+    // 返回false表示首条 GSO 消息即被拒绝且未发出任何数据，调用方可改为逐分片重发
+    // zerocopy 非空时经跟踪器以 MSG_ZEROCOPY 发送（调用方持有跟踪器锁）
+    bool sendSegments(SocketType sockfd, const sockaddr_in *dests, size_t dest_count,
+                      const iovec *iov, size_t iovcnt, size_t size, size_t segments, std::vector<bool> &results,
+                      ZeroCopyTracker *zerocopy = nullptr, const std::shared_ptr<const void> &owner = nullptr)
+    {
+        const size_t packet_size = static_cast<size_t>(config_.max_send_packet_size);
+        const size_t span = packet_size * segments;
+
+        // 消息划分只与数据有关，所有目标共用：每条消息 span 字节，跨越 iovec 边界时由多段组成
+        struct MsgSpan
+        {
+            size_t first;   // 在 pieces 中的起始下标
+            size_t count;
+            size_t length;
+        };
+        std::vector<iovec> pieces;
+        std::vector<MsgSpan> spans;
+        size_t index = 0, inner = 0;    // 当前 iovec 及其内偏移
+        for (size_t offset = 0; offset < size; offset += span)
+        {
+            MsgSpan msg_span = {pieces.size(), 0, std::min(span, size - offset)};
+            size_t remaining = msg_span.length;
+            while (remaining > 0 && index < iovcnt)
+            {
+                size_t take = std::min(remaining, iov[index].iov_len - inner);
+                if (take > 0)
+                    pieces.push_back({static_cast<char *>(iov[index].iov_base) + inner, take});
+                remaining -= take;
+                inner += take;
+                if (inner == iov[index].iov_len)
+                {
+                    ++index;
+                    inner = 0;
+                }
+            }
+            msg_span.count = pieces.size() - msg_span.first;
+            spans.push_back(msg_span);
+        }
+        const size_t msg_count = spans.size();
+
+        // 所有 GSO 消息分片大小相同，共用一份控制数据
+        union
+        {
+            cmsghdr align;
+            char buf[CMSG_SPACE(sizeof(uint16_t))];
+        } control = {};
+        if (segments > 1)
+        {
+            cmsghdr *cmsg = reinterpret_cast<cmsghdr *>(control.buf);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            uint16_t gso_size = static_cast<uint16_t>(packet_size);
+            memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+        }
+
+        const size_t total = dest_count * msg_count;
+        std::vector<mmsghdr> msgs(total);
+        for (size_t i = 0; i < total; ++i)
+        {
+            msghdr &hdr = msgs[i].msg_hdr;
+            hdr.msg_name = const_cast<sockaddr_in *>(&dests[i / msg_count]);
+            hdr.msg_namelen = sizeof(sockaddr_in);
+            const MsgSpan &msg_span = spans[i % msg_count];
+            hdr.msg_iov = &pieces[msg_span.first];
+            hdr.msg_iovlen = msg_span.count;
+            if (msg_span.length > packet_size)
+            {
+                hdr.msg_control = control.buf;
+                hdr.msg_controllen = sizeof(control.buf);
+            }
+        }
+
+#ifdef IO_URING_MODE
+        // 单条消息时 sendmmsg 同为一次系统调用且无需等待完成事件，只有批量发送经由io_uring
+        // 发送ring为所有socket共用，已被其他发送线程占用时直接使用 sendmmsg，不排队等待
+        if (send_ring_ && total > 1 && !zerocopy)
+        {
+            std::unique_lock<std::mutex> ring_lock(send_ring_mutex_, std::try_to_lock);
+            if (ring_lock.owns_lock())
+                return uringSendMsgs(sockfd, msgs, msg_count, segments > 1, results);
+        }
+#endif
+
+        size_t next = 0;
+        while (next < total)
+        {
+            unsigned int count = static_cast<unsigned int>(total - next);
+            int sent = zerocopy ? zerocopy->sendmmsg(msgs.data() + next, count, 0, owner)
+                                : sendmmsg(sockfd, msgs.data() + next, count, 0);
+            if (sent < 0)
+            {
+                if (next == 0 && segments > 1 && isGsoRejected(errno))
+                    return false;
+                if (zerocopy && errno == ENOBUFS)
+                {
+                    // 锁定页数超过 optmem 限制且等待通知后仍不足，其余消息拷贝发送
+                    LOG_WARNING("Zerocopy send out of option memory, sending remaining chunks by copy");
+                    zerocopy = nullptr;
+                    continue;
+                }
+                // 首条消息发送失败：记录该目标失败并跳过这一条，继续发送其余消息
+                size_t dest = next / msg_count;
+                LOG_ERROR("Failed to send chunk {} to target {} - {}", next % msg_count, dest, strerror(errno));
+                results[dest] = false;
+                ++next;
+                continue;
+            }
+            for (int i = 0; i < sent; ++i, ++next)
+            {
+                if (msgs[next].msg_len != spans[next % msg_count].length)
+                {
+                    LOG_ERROR("Failed to send complete chunk (sent {} of {} bytes)",
+                              msgs[next].msg_len, spans[next % msg_count].length);
+                    results[next / msg_count] = false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static size_t msgLength(const msghdr &hdr)
+    {
+        size_t length = 0;
+        for (size_t i = 0; i < hdr.msg_iovlen; ++i)
+        {
+            length += hdr.msg_iov[i].iov_len;
+        }
+        return length;
+    }
+
+    static bool isGsoRejected(int err)
+    {
+        return err == EIO || err == EINVAL || err == ENOPROTOOPT || err == EOPNOTSUPP;
+    }
+
+#ifdef DUAL_ENDPOINT_MODE
+    // 解析分片校验算法；接收端按分片头中的算法校验，与本端配置无关
+    void initFragmentChecksum()
+    {
+        if (!communicate::parse_checksum_type(config_.fragment_checksum, fragment_checksum_))
+        {
+            LOG_WARNING("Unknown fragment_checksum '{}', fragments are sent without checksum",
+                        config_.fragment_checksum);
+            fragment_checksum_ = communicate::ChecksumType::NONE;
+        }
+        if (config_.udp_fragment && fragment_checksum_ != communicate::ChecksumType::NONE)
+            LOG_INFO("Fragment checksum {} ({})", config_.fragment_checksum,
+                     communicate::checksum_implementation(fragment_checksum_));
+    }
+#endif
+
+    // 探测内核是否支持 UDP_SEGMENT（4.18+），不支持或配置关闭时发送始终逐分片进行
+    void initGso()
+    {
+        if (!config_.udp_gso)
+            return;
+        SocketType probe = socket(AF_INET, SOCK_DGRAM, 0);
+        int gso_size = 0;
+        socklen_t len = sizeof(gso_size);
+        bool supported = probe != INVALID_SOCKET &&
+                         getsockopt(probe, SOL_UDP, UDP_SEGMENT, &gso_size, &len) == 0;
+        if (probe != INVALID_SOCKET)
+            close(probe);
+        gso_enabled_.store(supported);
+        if (supported)
+            LOG_INFO("UDP GSO enabled, segment size {}", config_.max_send_packet_size);
         else
-            LOG_ERROR("Failed to send complete message to {}:{}", dest_addr, dest_port);
-        return success;
+            LOG_WARNING("UDP GSO not supported by kernel, using per-chunk send");
+    }
+#endif
+
+#ifdef IO_URING_MODE
+    // 每轮最多填满提交队列，一次提交并等待本轮全部完成
+    // 返回false表示 GSO 消息在首轮全部被拒绝（未发出任何数据）
+    bool uringSendMsgs(SocketType sockfd, const std::vector<mmsghdr> &msgs, size_t chunk_count,
+                       bool gso, std::vector<bool> &results)
+    {
+        const size_t round_size = send_ring_->sqEntries();
+        for (size_t begin = 0; begin < msgs.size(); begin += round_size)
+        {
+            size_t end = std::min(begin + round_size, msgs.size());
+            for (size_t i = begin; i < end; ++i)
+            {
+                send_ring_->prepSendMsg(sockfd, &msgs[i].msg_hdr, i);
+            }
+
+            unsigned pending = static_cast<unsigned>(end - begin);
+            size_t rejected = 0;
+            int reject_err = 0;
+            int ret = send_ring_->submit(pending);
+            while (pending > 0)
+            {
+                if (ret < 0 && ret != -EINTR)
+                {
+                    LOG_ERROR("io_uring send submit error: {}", strerror(-ret));
+                    for (size_t i = begin; i < end; ++i)
+                        results[i / chunk_count] = false;
+                    return true;
+                }
+                pending -= send_ring_->drainCompletions([&](const UringEngine::Completion &cqe) {
+                    size_t i = static_cast<size_t>(cqe.user_data);
+                    if (cqe.res != static_cast<int32_t>(msgLength(msgs[i].msg_hdr)))
+                    {
+                        if (gso && cqe.res < 0 && isGsoRejected(-cqe.res))
+                        {
+                            ++rejected;
+                            reject_err = -cqe.res;
+                            return;
+                        }
+                        LOG_ERROR("Failed to send chunk {} to target {} - {}", i % chunk_count, i / chunk_count,
+                                  cqe.res < 0 ? strerror(-cqe.res) : "partial send");
+                        results[i / chunk_count] = false;
+                    }
+                });
+                if (pending > 0)
+                    ret = send_ring_->submit(pending);
+            }
+
+            if (rejected > 0)
+            {
+                // 首轮全部被拒绝时交由调用方逐分片重发，否则按失败处理
+                if (begin == 0 && rejected == end - begin)
+                {
+                    errno = reject_err;
+                    return false;
+                }
+                LOG_ERROR("{} GSO messages rejected - {}", rejected, strerror(reject_err));
+                for (size_t i = begin; i < end; ++i)
+                    results[i / chunk_count] = false;
+            }
+        }
+        return true;
+    }
+#endif
+
+    static bool resolveAddr(const std::string &addr, int port, sockaddr_in &addr_in)
+    {
+        addr_in = {};
+        addr_in.sin_family = AF_INET;
+        addr_in.sin_port = htons(port);
+        return inet_pton(AF_INET, addr.c_str(), &addr_in.sin_addr) > 0;
+    }
+
+    bool addSubscriber(const std::string &addr, int port, communicate::SubscribebBase *sub)
+    {
+        uint64_t key = 0;
+        if (!SubscriberRouter::makeKey(addr, port, key))
+        {
+            LOG_ERROR("Invalid subscribe address {}:{}", addr, port);
+            return false;
+        }
+        LOG_DEBUG("Adding subscriber for {}:{} (key {:#x})", addr, port, key);
+        router_.add(key, sub);
+        return true;
+    }
+
+    // 清空缓存（正在使用的socket在发送结束后关闭）
+    void clearSendCache()
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        if (!send_cache_.empty() || cache_hits_.load() || cache_misses_.load())
+            LOG_INFO("Send socket cache: {} cached, {} hits, {} misses, {} evictions",
+                     send_cache_.size(), cache_hits_.load(), cache_misses_.load(), cache_evictions_.load());
+        send_cache_.clear();
+        cache_lru_.clear();
     }
 
-    void addSubscriber(const std::string &key, communicate::SubscribebBase *sub)
+    UdpCommunicateCore::SendCacheStats sendCacheStats()
     {
-        LOG_DEBUG("Adding subscriber for key: {}", key);
-        std::unique_lock<std::shared_mutex> lock(sub_mutex_);
-        subscribers_[key] = sub;
+        UdpCommunicateCore::SendCacheStats stats;
+        stats.hits = cache_hits_.load(std::memory_order_relaxed);
+        stats.misses = cache_misses_.load(std::memory_order_relaxed);
+        stats.evictions = cache_evictions_.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        stats.size = send_cache_.size();
+        return stats;
     }
 
-    communicate::SubscribebBase *getSubscriber(const std::string &key)
+    // 接收线程启动前设置
+    void setDatagramHandler(UdpCommunicateCore::DatagramHandler handler)
     {
-        LOG_TRACE("Get subscriber for key: {}", key);
-        std::shared_lock<std::shared_mutex> lock(sub_mutex_);
-        auto it = subscribers_.find(key);
-        LOG_DEBUG("Success subscriber for key: {}", it != subscribers_.end() ? key : "");
-        return it != subscribers_.end() ? it->second : nullptr;
+        datagram_handler_ = std::move(handler);
     }
 
-    static std::string createSubKey(const std::string &addr, int port)
+    // 绑定在 local_port 上的任一监听socket（多分片时同端口的socket均可用于发送），local_port 为0时取第一个
+    SocketType listenSocket(uint16_t local_port)
     {
-        return addr + ":" + std::to_string(port);
+        auto sockets = sockets_.read();
+        for (const auto &sock : *sockets)
+        {
+            if (local_port == 0 || sock.port == local_port)
+                return sock.fd;
+        }
+        return INVALID_SOCKET;
     }
 
 private:
@@ -224,20 +1020,271 @@ private:
     {
         SocketType fd;
         std::string addr_port;
+        uint16_t port = 0;                  // 实际绑定端口（绑定0时为系统分配的端口）
+        size_t shard = 0;                   // 所属接收分片
+    };
+
+#ifdef __linux__
+    // 接收控制数据缓冲（IP_PKTINFO 与 UDP_GRO 段长）
+    union RecvControl
+    {
+        cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(in_pktinfo)) + CMSG_SPACE(sizeof(int))];
     };
 
+    struct RecvMeta
+    {
+        uint64_t local_key = 0;
+        size_t segment_size = 0;    // GRO 合并时每个原始数据报的长度，0 表示未合并
+    };
+
+    // epoll 事件携带 socket 与其绑定端口，收包时无需再查询
+    static uint64_t epollTag(SocketType sockfd, uint16_t port)
+    {
+        return (static_cast<uint64_t>(port) << 32) | static_cast<uint32_t>(sockfd);
+    }
+
+    // 解析接收控制数据
+    // 本地地址取自 IP_PKTINFO（数据报实际目的地址，绑定 INADDR_ANY 时也能区分网卡），端口使用缓存的绑定端口
+    static RecvMeta parseControl(msghdr &msg, SocketType sockfd, uint16_t local_port)
+    {
+        RecvMeta meta;
+        bool has_pktinfo = false;
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO)
+            {
+                in_pktinfo info;
+                memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+                meta.local_key = SubscriberRouter::endpointKey(ntohl(info.ipi_addr.s_addr), local_port);
+                has_pktinfo = true;
+            }
+            else if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+            {
+                int segment_size = 0;
+                memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+                meta.segment_size = static_cast<size_t>(segment_size);
+            }
+        }
+
+        if (!has_pktinfo)
+        {
+            // 未携带控制数据（设置 IP_PKTINFO 失败）时回退为查询绑定地址
+            sockaddr_in local_addr = {};
+            getLocalAddr(sockfd, local_addr);
+            meta.local_key = SubscriberRouter::endpointKey(local_addr);
+        }
+        return meta;
+    }
+
+    // recvmmsg 使用的接收缓冲（仅所属分片的接收线程访问），缓冲取自接收缓冲池
+    struct RecvBatch
+    {
+        std::shared_ptr<BufferPool> pool;
+        std::vector<iovec> iovecs;
+        std::vector<sockaddr_in> addrs;
+        std::vector<RecvControl> controls;
+        std::vector<mmsghdr> msgs;
+
+        ~RecvBatch()
+        {
+            clear();
+        }
+
+        void prepare(size_t batch_size, std::shared_ptr<BufferPool> buffer_pool)
+        {
+            clear();
+            pool = std::move(buffer_pool);
+            iovecs.resize(batch_size);
+            addrs.resize(batch_size);
+            controls.resize(batch_size);
+            msgs.resize(batch_size);
+            for (auto &iov : iovecs)
+            {
+                iov.iov_base = pool->acquire();
+                iov.iov_len = pool->blockSize();
+            }
+        }
+
+        // 归还尚未使用的缓冲
+        void clear()
+        {
+            for (auto &iov : iovecs)
+            {
+                pool->release(static_cast<char *>(iov.iov_base));
+            }
+            iovecs.clear();
+        }
+
+        // 取走已收到数据的缓冲交给订阅者，原位置补充新缓冲
+        std::shared_ptr<void> take(size_t i)
+        {
+            char *data = static_cast<char *>(iovecs[i].iov_base);
+            iovecs[i].iov_base = pool->acquire();
+            return pool->share(data);
+        }
+
+        // recvmmsg 会改写 msg_namelen 等字段，每次调用前重置
+        void reset()
+        {
+            for (size_t i = 0; i < msgs.size(); ++i)
+            {
+                msgs[i] = {};
+                msgs[i].msg_hdr.msg_name = &addrs[i];
+                msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                msgs[i].msg_hdr.msg_iov = &iovecs[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+                msgs[i].msg_hdr.msg_control = controls[i].buf;
+                msgs[i].msg_hdr.msg_controllen = sizeof(controls[i].buf);
+            }
+        }
+    };
+#endif
+
+    // 接收分片：每个分片一个接收线程，Linux下各自持有epoll实例与唤醒用eventfd
+    struct RecvShard
+    {
+        size_t index = 0;
+        std::thread thread;
+        SubscriberRouter::FlowCache flows;  // 仅本分片接收线程访问
+#ifdef DUAL_ENDPOINT_MODE
+        std::unique_ptr<FragmentReassembler> reassembler;   // 分片模式下创建，仅本分片接收线程访问
+#endif
+#ifdef __linux__
+        int epoll_fd = -1;
+        int wakeup_fd = -1;
+        RecvBatch batch;
+
+        ~RecvShard()
+        {
+            if (epoll_fd >= 0)
+                close(epoll_fd);
+            if (wakeup_fd >= 0)
+                close(wakeup_fd);
+        }
+#endif
+    };
+
+    static std::unique_ptr<RecvShard> createShard(size_t index)
+    {
+        auto shard = std::make_unique<RecvShard>();
+        shard->index = index;
+#ifdef __linux__
+        // 常驻的epoll实例，监听socket在添加时注册一次；eventfd用于唤醒接收线程
+        shard->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        shard->wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (shard->epoll_fd < 0 || shard->wakeup_fd < 0)
+        {
+            LOG_ERROR("Failed to create epoll/eventfd: {}", strerror(errno));
+        }
+        else
+        {
+            epoll_event ev = {};
+            ev.events = EPOLLIN;
+            ev.data.u64 = epollTag(shard->wakeup_fd, 0);
+            epoll_ctl(shard->epoll_fd, EPOLL_CTL_ADD, shard->wakeup_fd, &ev);
+        }
+#endif
+        return shard;
+    }
+
     /* 拓展可参考sogou/workflow 实现轮询线程池 */
-    void receiverLoop()
+    void receiverLoop(RecvShard *shard)
     {
-        LOG_INFO("Receiver thread started");
-        constexpr int BUFFER_SIZE = 65536;
-        char buffer[BUFFER_SIZE];
+        LOG_INFO("Receiver thread {} started", shard->index);
+#ifdef DUAL_ENDPOINT_MODE
+        if (config_.udp_fragment)
+        {
+            shard->reassembler = std::make_unique<FragmentReassembler>(
+                static_cast<size_t>(config_.fragment_max_message_size),
+                static_cast<size_t>(config_.fragment_max_pending_bytes), config_.fragment_timeout_ms);
+        }
+#endif
+#ifdef IO_URING_MODE
+        if (config_.io_backend == "io_uring" && uringReceiverLoop(*shard))
+        {
+            LOG_INFO("Receiver thread {} exiting", shard->index);
+            return;
+        }
+#endif
+#ifdef __linux__
+        if (config_.recv_batch_size > 1)
+        {
+            shard->batch.prepare(config_.recv_batch_size, recv_pool_);
+            LOG_DEBUG("Batch receive enabled, batch size: {}", config_.recv_batch_size);
+        }
+#endif
+
+#ifdef __linux__
+        constexpr int MAX_EVENTS = 64;
+        epoll_event events[MAX_EVENTS];
+        // 首个分片兼做连接池socket的零拷贝完成回收，启用零拷贝时定期醒来
+        const bool reap_zerocopy = shard->index == 0 && config_.zerocopy_threshold > 0;
+        auto last_reap = std::chrono::steady_clock::now();
+
+        while (is_running_.load())
+        {
+            // 数据到达或stop()写入eventfd时返回；其余分片无超时等待
+            int ret = epoll_wait(shard->epoll_fd, events, MAX_EVENTS,
+                                 reap_zerocopy ? ZeroCopyTracker::REAP_INTERVAL_MS : -1);
+            if (reap_zerocopy)
+            {
+                auto now = std::chrono::steady_clock::now();
+                if (now - last_reap >= std::chrono::milliseconds(ZeroCopyTracker::REAP_INTERVAL_MS))
+                {
+                    last_reap = now;
+                    reapZeroCopy();
+                }
+            }
+            if (ret < 0)
+            {
+                if (errno != EINTR)
+                    LOG_ERROR("epoll_wait error: {}", strerror(errno));
+                continue;
+            }
 
+            for (int i = 0; i < ret; ++i)
+            {
+                SocketType sockfd = static_cast<SocketType>(events[i].data.u64 & 0xFFFFFFFF);
+                if (sockfd == shard->wakeup_fd)
+                {
+                    uint64_t count = 0;
+                    while (read(shard->wakeup_fd, &count, sizeof(count)) > 0) {}
+                    LOG_TRACE("Receiver thread woken up");
+                    continue;
+                }
+                if (events[i].events & EPOLLIN)
+                {
+                    LOG_TRACE("Data available on socket {}", sockfd);
+                    processIncomingData(*shard, sockfd, static_cast<uint16_t>(events[i].data.u64 >> 32));
+                }
+            }
+        }
+#else
+#ifdef _WIN32
+        std::vector<WSAPOLLFD> pollfds;
+#else
+        std::vector<pollfd> pollfds;
+#endif
+        std::vector<uint16_t> ports;    // 与 pollfds 一一对应的绑定端口
+        uint64_t sockets_version = ~0ULL;
         while (is_running_.load())
         {
-            std::vector<ListeningSocket> sockets = getCurrentSockets();
+            // 监听socket集合变化时才重建poll集合
+            if (sockets_.version() != sockets_version)
+            {
+                sockets_version = sockets_.version();
+                auto sockets = sockets_.read();
+                pollfds.clear();
+                ports.clear();
+                for (const auto &sock : *sockets)
+                {
+                    pollfds.push_back({sock.fd, POLLIN, 0});
+                    ports.push_back(sock.port);
+                }
+            }
 
-            if (sockets.empty())
+            if (pollfds.empty())
             {
                 LOG_TRACE("No sockets to poll, sleeping");
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -246,18 +1293,8 @@ private:
 
             // 平台相关的poll实现
 #ifdef _WIN32
-            std::vector<WSAPOLLFD> pollfds;
-            for (const auto &sock : sockets)
-            {
-                pollfds.push_back({sock.fd, POLLIN, 0});
-            }
             int ret = WSAPoll(pollfds.data(), static_cast<ULONG>(pollfds.size()), 100);
 #else
-            std::vector<pollfd> pollfds;
-            for (const auto &sock : sockets)
-            {
-                pollfds.push_back({sock.fd, POLLIN, 0});
-            }
             int ret = poll(pollfds.data(), pollfds.size(), 100);
 #endif
 
@@ -278,88 +1315,365 @@ private:
                 {
                     LOG_TRACE("Data available on socket {}", i);
                     // recvfrom，getsockname 非线程安全操作，不将整个处理加入线程池
-                    processIncomingData(pollfds[i].fd);
+                    processIncomingData(*shard, pollfds[i].fd, ports[i]);
                 }
             }
         }
-        LOG_INFO("Receiver thread exiting");
+#endif
+        LOG_INFO("Receiver thread {} exiting", shard->index);
     }
 
-    void processIncomingData(SocketType sockfd)
+    // local_port 为监听socket缓存的绑定端口
+    void processIncomingData(RecvShard &shard, SocketType sockfd, uint16_t local_port)
     {
-        // 使用配置的最大包大小
-        std::vector<char> buffer(config_.max_receive_packet_size);
+#ifdef __linux__
+        if (config_.recv_batch_size > 1)
+        {
+            processIncomingBatch(shard, sockfd, local_port);
+            return;
+        }
+#endif
+        // 直接接收到缓冲池的缓冲中，随后整块交给订阅者（避免拷贝）
+        char *buffer = recv_pool_->acquire();
         // 接收数据（获取发送方信息）
         sockaddr_in src_addr = {};
+#ifdef __linux__
+        // 本地地址随数据报以 IP_PKTINFO 控制数据返回，无需再查询
+        iovec iov = {buffer, recv_pool_->blockSize()};
+        RecvControl control;
+        msghdr msg = {};
+        msg.msg_name = &src_addr;
+        msg.msg_namelen = sizeof(src_addr);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+        ssize_t recv_len = recvmsg(sockfd, &msg, 0);
+#else
         socklen_t addr_len = sizeof(src_addr);
-        ssize_t recv_len = recvfrom(sockfd, buffer.data(), config_.max_receive_packet_size, 0,
+        ssize_t recv_len = recvfrom(sockfd, buffer, config_.max_receive_packet_size, 0,
                                     reinterpret_cast<sockaddr *>(&src_addr), &addr_len);
+#endif
         if (recv_len <= 0)
         {
             LOG_ERROR("recvfrom failed: {}", strerror(errno));
+            recv_pool_->release(buffer);
             return;
         }
 
         LOG_DEBUG("Received {} bytes from socket {}", recv_len, sockfd);
 
-        // 复制数据到共享内存（避免线程竞争）
-        auto msg_data = std::shared_ptr<void>(malloc(recv_len), free);
-        memcpy(msg_data.get(), buffer.data(), recv_len);
+        auto msg_data = recv_pool_->share(buffer);
 
-        // 获取发送方IP和端口
-        char src_ip[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &src_addr.sin_addr, src_ip, INET_ADDRSTRLEN);
-        int src_port = ntohs(src_addr.sin_port);
         // 获取本地该消息来源IP和端口
+#ifdef __linux__
+        RecvMeta meta = parseControl(msg, sockfd, local_port);
+        uint64_t local_key = meta.local_key;
+#else
         sockaddr_in local_addr = {};
-        socklen_t local_addr_len = sizeof(local_addr);
-        char local_ip[INET_ADDRSTRLEN] = {0};
-        int local_port = 0;
-        if (getsockname(sockfd, (sockaddr *)&local_addr, &local_addr_len) == 0)
+        getLocalAddr(sockfd, local_addr);
+        uint64_t local_key = SubscriberRouter::endpointKey(ntohl(local_addr.sin_addr.s_addr), local_port);
+#endif
+
+        uint64_t src_key = SubscriberRouter::endpointKey(src_addr);
+        auto sub = shard.flows.route(router_, src_key, local_key);
+        if (!sub && !datagram_handler_)
         {
-            inet_ntop(AF_INET, &local_addr.sin_addr, local_ip, INET_ADDRSTRLEN);
-            local_port = ntohs(local_addr.sin_port);
+            LOG_WARNING("No subscriber found for message");
+            return;
         }
 
-        LOG_TRACE("Message from {}:{} to {}:{}", src_ip, src_port, local_ip, local_port);
-
-        // 捕获关键信息（避免线程间传递复杂对象）
-        struct MatchContext
+        size_t segment_size = 0;
+#ifdef __linux__
+        segment_size = meta.segment_size;
+#endif
+        if ((segment_size > 0 && static_cast<size_t>(recv_len) > segment_size) || config_.udp_fragment ||
+            datagram_handler_)
         {
-            std::string sender_key;
-            std::string local_key;
-            std::string wildcard_key;
-            std::string any_key;
+            // GRO 合并的多个数据报拆分（分片模式下经重组）后整批分发
+            auto batch = std::make_shared<std::vector<BatchItem>>();
+            appendSegments(shard, *batch, sub, src_key, local_key, msg_data, recv_len, segment_size);
+            dispatchBatch(std::move(batch));
+            return;
+        }
+
+        // 生成处理任务
+        auto process_msg = [sub, msg_data] {
+            sub->handleMsg(msg_data);
         };
-        auto context = std::make_shared<MatchContext>();
-        context->sender_key = createSubKey(src_ip, src_port);           // 精确发送方
-        context->local_key = createSubKey(local_ip, local_port);        // 精确本地
-        context->wildcard_key = createSubKey("localhost", local_port);  // 本地通用匹配前缀+指定端口
-        context->any_key = createSubKey("", 0);                         // 完全通配
-
-        // 生成匹配任务
-        auto process_msg = [this, context, msg_data] {
-            if (auto sub = getSubscriber(context->sender_key) ?:
-                           getSubscriber(context->local_key)  ?:
-                           getSubscriber(context->wildcard_key) ?:
-                           getSubscriber(context->any_key))
+
+#ifdef THREAD_POOL_MODE
+        UdpCommunicateCore::s_thread_pool_->enqueue(process_msg);
+#else
+        process_msg();
+#endif
+    }
+
+#ifdef __linux__
+    // 使用 recvmmsg 一次取出最多 recv_batch_size 个数据报，整批交给分发阶段
+    void processIncomingBatch(RecvShard &shard, SocketType sockfd, uint16_t local_port)
+    {
+        RecvBatch &recv_batch = shard.batch;
+        recv_batch.reset();
+        int count = recvmmsg(sockfd, recv_batch.msgs.data(), static_cast<unsigned int>(recv_batch.msgs.size()),
+                             MSG_DONTWAIT, nullptr);
+        if (count <= 0)
+        {
+            if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+                LOG_ERROR("recvmmsg failed: {}", strerror(errno));
+            return;
+        }
+
+        LOG_DEBUG("Received {} datagrams from socket {}", count, sockfd);
+
+        auto batch = std::make_shared<std::vector<BatchItem>>();
+        batch->reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            if (recv_batch.msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
             {
-                sub->handleMsg(msg_data);
+                LOG_WARNING("Datagram truncated to {} bytes", recv_batch.msgs[i].msg_len);
             }
-            else
+
+            RecvMeta meta = parseControl(recv_batch.msgs[i].msg_hdr, sockfd, local_port);
+            uint64_t src_key = SubscriberRouter::endpointKey(recv_batch.addrs[i]);
+            auto sub = shard.flows.route(router_, src_key, meta.local_key);
+            if (!sub && !datagram_handler_)
             {
                 LOG_WARNING("No subscriber found for message");
+                continue;
+            }
+            appendSegments(shard, *batch, sub, src_key, meta.local_key, recv_batch.take(i),
+                           recv_batch.msgs[i].msg_len, meta.segment_size);
+        }
+
+        dispatchBatch(std::move(batch));
+    }
+#endif
+
+#ifdef IO_URING_MODE
+    // io_uring 接收循环：分片内每个监听socket挂载一个multishot recvmsg，数据写入提供缓冲环
+    // 返回false表示内核不支持（调用方回退到epoll）
+    bool uringReceiverLoop(RecvShard &shard)
+    {
+        constexpr uint16_t URING_BUF_GROUP = 0;
+        constexpr uint64_t WAKEUP_TAG = ~0ULL;
+
+        // 提供给内核的缓冲取自接收缓冲池；须先于 ring 构造，保证 ring 关闭后才归还
+        struct RingBuffers
+        {
+            std::shared_ptr<BufferPool> pool;
+            std::vector<char *> blocks;
+            ~RingBuffers()
+            {
+                for (char *block : blocks)
+                    pool->release(block);
+            }
+        } ring_buffers{recv_pool_, {}};
+        for (int i = 0; i < config_.uring_buf_count; ++i)
+        {
+            ring_buffers.blocks.push_back(recv_pool_->acquire());
+        }
+
+        UringEngine ring;
+        if (!ring.init(config_.uring_entries) ||
+            !ring.setupBufferRing(URING_BUF_GROUP, config_.uring_buf_count,
+                                  static_cast<unsigned>(recv_pool_->blockSize()), ring_buffers.blocks.data()))
+        {
+            LOG_WARNING("io_uring receive unavailable ({}), falling back to epoll", strerror(errno));
+            return false;
+        }
+
+        // multishot recvmsg 只读取 namelen/controllen 用于划分缓冲布局
+        msghdr recv_msg = {};
+        recv_msg.msg_namelen = sizeof(sockaddr_in);
+        recv_msg.msg_controllen = sizeof(RecvControl);
+
+        uint64_t wakeup_value = 0;
+        std::unordered_map<SocketType, uint16_t> armed;     // 已挂载接收的socket -> 绑定端口
+        auto armNewSockets = [&] {
+            auto sockets = sockets_.read();
+            for (const auto &sock : *sockets)
+            {
+                if (sock.shard != shard.index || armed.count(sock.fd))
+                    continue;
+                armed[sock.fd] = sock.port;
+                ring.prepRecvMsgMultishot(sock.fd, &recv_msg, static_cast<uint64_t>(sock.fd));
+            }
+        };
+
+        ring.prepRead(shard.wakeup_fd, &wakeup_value, sizeof(wakeup_value), WAKEUP_TAG);
+        armNewSockets();
+        LOG_INFO("Receiver thread {} using io_uring backend", shard.index);
+
+        bool unsupported = false;
+        while (is_running_.load() && !unsupported)
+        {
+            int ret = ring.submit(1);
+            if (ret < 0 && ret != -EINTR)
+            {
+                LOG_ERROR("io_uring submit error: {}", strerror(-ret));
+            }
+
+            auto batch = std::make_shared<std::vector<BatchItem>>();
+            ring.drainCompletions([&](const UringEngine::Completion &cqe) {
+                if (cqe.user_data == WAKEUP_TAG)
+                {
+                    // 新增监听socket或stop()唤醒
+                    ring.prepRead(shard.wakeup_fd, &wakeup_value, sizeof(wakeup_value), WAKEUP_TAG);
+                    armNewSockets();
+                    return;
+                }
+
+                SocketType sockfd = static_cast<SocketType>(cqe.user_data);
+                if (cqe.res < 0)
+                {
+                    if (cqe.res == -EINVAL)
+                    {
+                        // 内核不支持multishot recvmsg（< 6.0）
+                        LOG_WARNING("io_uring multishot recvmsg not supported by kernel, falling back to epoll");
+                        unsupported = true;
+                        return;
+                    }
+                    if (cqe.res != -ENOBUFS)
+                        LOG_ERROR("io_uring recvmsg failed on socket {}: {}", sockfd, strerror(-cqe.res));
+                }
+                else if (cqe.hasBuffer())
+                {
+                    sockaddr *name = nullptr;
+                    char *payload = nullptr;
+                    size_t payload_len = 0;
+                    bool truncated = false;
+                    uint16_t bid = cqe.bufferId();
+                    char *buf = ring.buffer(bid);
+                    msghdr control = {};
+                    RecvMeta meta;
+                    uint64_t src_key = 0;
+                    communicate::SubscribebBase *sub = nullptr;
+                    bool parsed = UringEngine::parseRecvMsg(buf, cqe.res, &recv_msg, &name, &payload, &payload_len,
+                                                            &truncated, &control);
+                    if (parsed)
+                    {
+                        if (truncated)
+                            LOG_WARNING("Datagram truncated to {} bytes", payload_len);
+                        meta = parseControl(control, sockfd, armed[sockfd]);
+                        src_key = SubscriberRouter::endpointKey(*reinterpret_cast<sockaddr_in *>(name));
+                        sub = shard.flows.route(router_, src_key, meta.local_key);
+                        if (!sub && !datagram_handler_)
+                            LOG_WARNING("No subscriber found for message");
+                    }
+
+                    if (parsed && (sub || datagram_handler_))
+                    {
+                        // 缓冲整块交给订阅者（指向数据起始处），以新缓冲顶替归还内核
+                        appendSegments(shard, *batch, sub, src_key, meta.local_key,
+                                       recv_pool_->share(buf, payload), payload_len, meta.segment_size);
+                        ring_buffers.blocks[bid] = recv_pool_->acquire();
+                        ring.replaceBuffer(bid, ring_buffers.blocks[bid]);
+                    }
+                    else
+                    {
+                        ring.recycleBuffer(bid);
+                    }
+                }
+
+                // multishot 请求终止（缓冲耗尽等）时重新挂载
+                if (!cqe.hasMore())
+                    ring.prepRecvMsgMultishot(sockfd, &recv_msg, cqe.user_data);
+            });
+
+            if (!batch->empty())
+            {
+                LOG_DEBUG("Received {} datagrams via io_uring", batch->size());
+                dispatchBatch(std::move(batch));
+            }
+        }
+
+        return !unsupported;
+    }
+#endif
+
+    // 接收线程内已完成路由匹配，分发阶段只调用订阅者
+    using BatchItem = std::pair<communicate::SubscribebBase *, std::shared_ptr<void>>;
+
+    // GRO 合并的数据按段长拆分为多个数据报视图，共享同一缓冲（别名 shared_ptr，无拷贝）
+    void appendSegments(RecvShard &shard, std::vector<BatchItem> &batch, communicate::SubscribebBase *sub,
+                        uint64_t src_key, uint64_t local_key, const std::shared_ptr<void> &msg_data, size_t len,
+                        size_t segment_size)
+    {
+        if (segment_size == 0 || len <= segment_size)
+        {
+            appendDatagram(shard, batch, sub, src_key, local_key, msg_data, len);
+            return;
+        }
+        char *base = static_cast<char *>(msg_data.get());
+        for (size_t offset = 0; offset < len; offset += segment_size)
+        {
+            appendDatagram(shard, batch, sub, src_key, local_key, std::shared_ptr<void>(msg_data, base + offset),
+                           std::min(segment_size, len - offset));
+        }
+    }
+
+    // 设置了原始数据报处理时直接交给它（在接收线程内调用）；分片模式下数据报先经重组，消息完整后才加入批次
+    void appendDatagram(RecvShard &shard, std::vector<BatchItem> &batch, communicate::SubscribebBase *sub,
+                        uint64_t src_key, uint64_t local_key, const std::shared_ptr<void> &msg_data, size_t len)
+    {
+        if (datagram_handler_)
+        {
+            datagram_handler_(sub, src_key, local_key, msg_data, len);
+            return;
+        }
+#ifdef DUAL_ENDPOINT_MODE
+        if (shard.reassembler)
+        {
+            std::shared_ptr<void> message;
+            switch (shard.reassembler->add(src_key, msg_data, len, message))
+            {
+            case FragmentReassembler::Result::COMPLETE:
+                batch.emplace_back(sub, std::move(message));
+                return;
+            case FragmentReassembler::Result::PENDING:
+                return;
+            case FragmentReassembler::Result::DROPPED:
+                LOG_DEBUG("Dropped invalid, corrupted or duplicate fragment ({} bytes)", len);
+                return;
+            case FragmentReassembler::Result::NOT_FRAGMENT:
+                break;
+            }
+        }
+#else
+        (void)shard;
+#endif
+        batch.emplace_back(sub, msg_data);
+    }
+
+    // 整批生成一个处理任务
+    void dispatchBatch(std::shared_ptr<std::vector<BatchItem>> batch)
+    {
+        if (batch->empty())
+            return;
+
+        auto process_batch = [batch] {
+            for (const auto &[sub, msg_data] : *batch)
+            {
+                sub->handleMsg(msg_data);
             }
         };
 
 #ifdef THREAD_POOL_MODE
-        UdpCommunicateCore::s_thread_pool_->enqueue(process_msg);
+        UdpCommunicateCore::s_thread_pool_->enqueue(process_batch);
 #else
-        process_msg();
+        process_batch();
 #endif
     }
 
-    SocketType createAndBindSocket(const std::string &addr, int port)
+    static bool getLocalAddr(SocketType sockfd, sockaddr_in &local_addr)
+    {
+        socklen_t local_addr_len = sizeof(local_addr);
+        return getsockname(sockfd, (sockaddr *)&local_addr, &local_addr_len) == 0;
+    }
+
+    SocketType createAndBindSocket(const std::string &addr, int port, bool reuse_port = false)
     {
         // 1. 创建 UDP Socket
         // AF_INET: IPv4 地址族
@@ -385,6 +1699,26 @@ private:
 #endif
             return INVALID_SOCKET;
         }
+#ifdef __linux__
+        // 多分片接收时同一地址打开多个socket，由内核按四元组哈希（或CBPF）分配数据包
+        if (reuse_port && setsockopt(sockfd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) == SOCKET_ERROR)
+        {
+            LOG_ERROR("Failed to set SO_REUSEPORT: {}", strerror(errno));
+            close(sockfd);
+            return INVALID_SOCKET;
+        }
+        // 接收时随数据报返回目的地址，用于本地地址匹配订阅者
+        if (setsockopt(sockfd, IPPROTO_IP, IP_PKTINFO, &opt, sizeof(opt)) == SOCKET_ERROR)
+        {
+            LOG_WARNING("Failed to set IP_PKTINFO, local address lookup falls back to getsockname: {}",
+                        strerror(errno));
+        }
+        // 同一流的连续数据报由内核合并后一次交付，接收时再按段长拆分
+        if (config_.udp_gro && setsockopt(sockfd, SOL_UDP, UDP_GRO, &opt, sizeof(opt)) == SOCKET_ERROR)
+        {
+            LOG_WARNING("Failed to enable UDP_GRO: {}", strerror(errno));
+        }
+#endif
         // 3. 初始化服务器地址结构
         sockaddr_in serv_addr = {};
         serv_addr.sin_family = AF_INET;         // IPv4 地址族
@@ -423,52 +1757,140 @@ private:
     {
         LOG_DEBUG("Closing all sockets");
         std::lock_guard<std::mutex> lock(socket_mutex_);
-        for (const auto &sock : sockets_)
-        {
+        sockets_.update([](std::vector<ListeningSocket> &sockets) {
+            for (const auto &sock : sockets)
+            {
 #ifdef _WIN32
-            closesocket(sock.fd);
+                closesocket(sock.fd);
 #else
-            close(sock.fd);
+                close(sock.fd);
 #endif
-        }
-        sockets_.clear();
+            }
+            sockets.clear();
+        });
     }
 
-    std::vector<ListeningSocket> getCurrentSockets()
+#ifdef __linux__
+    // 回收连接池socket上已完成的零拷贝发送，发送后长时间无后续发送时调用方的缓冲也能及时释放
+    void reapZeroCopy()
     {
-        std::lock_guard<std::mutex> lock(socket_mutex_);
-        return sockets_;
+        auto pool = conn_pool_.read();
+        for (const auto &[key, conn] : *pool)
+        {
+            if (conn.zerocopy)
+                conn.zerocopy->tryReap();
+        }
     }
+#endif
 
     void cleanIdleConnections()
     {
         LOG_TRACE("Clean up the connection pool");
+        clearSendCache();
         std::lock_guard<std::mutex> lock(socket_mutex_);
 
-        for (auto &[_, socket] : conn_pool_)
+#ifdef __linux__
         {
-#ifdef _WIN32
-            closesocket(socket);
-#else
-            close(socket);
-#endif
+            auto pool = conn_pool_.read();
+            for (const auto &[key, conn] : *pool)
+            {
+                if (conn.zerocopy)
+                {
+                    // 关闭后内核不再上报完成通知，先等待已发出的零拷贝数据
+                    std::lock_guard<std::mutex> zc_lock(conn.zerocopy->mutex());
+                    if (!conn.zerocopy->wait(config_.send_timeout_ms))
+                        LOG_WARNING("Closing send socket {} with {} zerocopy sends pending",
+                                    key, conn.zerocopy->pending());
+                }
+            }
         }
-        conn_pool_.clear();
+#endif
+        // socket 由最后一个持有者（连接池或仍存活的 Endpoint 句柄）关闭
+        conn_pool_.update([](ConnPool &pool) { pool.clear(); });
     }
 
     // 获取连接
-    SocketType getConnection(const std::string &addr, int port)
+    SendConn getConnection(const std::string &addr, int port)
     {
         std::string key = addr + ":" + std::to_string(port);
 
         // 尝试从连接池获取
-        auto it = conn_pool_.find(key);
-        if (it != conn_pool_.end())
+        auto pool = conn_pool_.read();
+        auto it = pool->find(key);
+        if (it != pool->end())
         {
             return it->second;
         }
 
-        return INVALID_SOCKET;
+        return {};
+    }
+
+    // 取得不在连接池中的目标的缓存socket，未命中时创建并加入缓存（超出容量时淘汰最久未使用的）
+    SendConn getCachedConnection(const std::string &addr, int port)
+    {
+        std::string key = addr + ":" + std::to_string(port);
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            evictIdleCached(now);
+            auto it = send_cache_.find(key);
+            if (it != send_cache_.end())
+            {
+                cache_hits_.fetch_add(1, std::memory_order_relaxed);
+                it->second.last_used = now;
+                cache_lru_.splice(cache_lru_.begin(), cache_lru_, it->second.lru);
+                return it->second.conn;
+            }
+        }
+        cache_misses_.fetch_add(1, std::memory_order_relaxed);
+
+        // 创建socket不持有缓存锁
+        SendConn conn;
+        if (!resolveAddr(addr, port, conn.dest_addr))
+        {
+            LOG_ERROR("Invalid destination address: {}", addr);
+            return {};
+        }
+        conn.fd = createSendSocket(addr, port);
+        if (conn.fd == INVALID_SOCKET)
+            return {};
+        conn.closer.reset(new SocketGuard{conn.fd});
+        conn.send_mutex = std::make_shared<std::mutex>();
+
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto it = send_cache_.find(key);
+        if (it != send_cache_.end())
+            return it->second.conn;     // 其他线程已同时创建，本次创建的socket随 conn 析构关闭
+
+        while (send_cache_.size() >= static_cast<size_t>(config_.send_cache_size))
+        {
+            LOG_DEBUG("Evicting least recently used send socket {}", cache_lru_.back());
+            send_cache_.erase(cache_lru_.back());
+            cache_lru_.pop_back();
+            cache_evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+        cache_lru_.push_front(key);
+        send_cache_.emplace(key, CachedConn{conn, cache_lru_.begin(), now});
+        LOG_DEBUG("Cached send socket for {} ({} cached)", key, send_cache_.size());
+        return conn;
+    }
+
+    // 关闭空闲超时的缓存socket，每次访问缓存时执行（调用方持有 cache_mutex_）
+    void evictIdleCached(std::chrono::steady_clock::time_point now)
+    {
+        if (config_.send_cache_idle_ms <= 0)
+            return;
+        auto idle = std::chrono::milliseconds(config_.send_cache_idle_ms);
+        while (!cache_lru_.empty())
+        {
+            auto it = send_cache_.find(cache_lru_.back());
+            if (now - it->second.last_used < idle)
+                break;
+            LOG_DEBUG("Closing idle send socket {}", it->first);
+            send_cache_.erase(it);
+            cache_lru_.pop_back();
+            cache_evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
     // 创建发送socket
@@ -541,13 +1963,37 @@ private:
 
     std::atomic<bool> is_running_;
     CoreConfig &config_;            // 引用类型，外部修改同步至内部
-    std::thread receiver_thread_;
-    std::mutex send_mutex_;
-    std::shared_mutex sub_mutex_;   // 读写锁
+    std::vector<std::unique_ptr<RecvShard>> shards_;    // 接收分片（启动后不再变化）
+    std::shared_ptr<BufferPool> recv_pool_;             // 接收缓冲池（start 时按配置创建）
+    UdpCommunicateCore::DatagramHandler datagram_handler_;  // 非空时接收的数据报不经订阅者分发
     std::mutex socket_mutex_;
-    std::vector<ListeningSocket> sockets_;
-    std::unordered_map<std::string, communicate::SubscribebBase *> subscribers_;
-    std::unordered_map<std::string, SocketType> conn_pool_; // 连接池结构 Key: "addr:port"
+    std::atomic<bool> gso_enabled_{false};  // 内核支持且未被拒绝过时使用 UDP GSO 发送
+#ifdef DUAL_ENDPOINT_MODE
+    std::atomic<uint32_t> next_msg_id_{0};  // 分片模式下的消息编号
+    communicate::ChecksumType fragment_checksum_ = communicate::ChecksumType::NONE;  // 分片校验算法（初始化时确定）
+#endif
+    RcuSnapshot<std::vector<ListeningSocket>> sockets_;    // 写操作在 socket_mutex_ 下进行
+    SubscriberRouter router_;       // 订阅者路由表
+    using ConnPool = std::unordered_map<std::string, SendConn>;
+    RcuSnapshot<ConnPool> conn_pool_;       // 连接池结构 Key: "addr:port"，写操作在 socket_mutex_ 下进行
+    // 不在连接池中的目标的发送socket缓存（LRU，cache_lru_ 队首为最近使用）
+    struct CachedConn
+    {
+        SendConn conn;
+        std::list<std::string>::iterator lru;
+        std::chrono::steady_clock::time_point last_used;
+    };
+    std::mutex cache_mutex_;
+    std::list<std::string> cache_lru_;
+    std::unordered_map<std::string, CachedConn> send_cache_;
+    std::atomic<uint64_t> cache_hits_{0};
+    std::atomic<uint64_t> cache_misses_{0};
+    std::atomic<uint64_t> cache_evictions_{0};
+#ifdef IO_URING_MODE
+    std::mutex send_ring_mutex_;
+    std::unique_ptr<UringEngine> send_ring_;    // 为空时使用sendmmsg
+#endif
+
 };
 
 #ifdef THREAD_POOL_MODE
@@ -579,19 +2025,67 @@ int UdpCommunicateCore::initialize()
     m_config.source_addr.source_port = cfg.getValue("source_port", 0);
     m_config.source_addr.source_ip = cfg.getValue("source_ip", (std::string) "");
     m_config.thread_pool_size = cfg.getValue("thread_pool_size", 3);
+    m_config.thread_pool_scheduler = cfg.getValue("thread_pool_scheduler", (std::string) "queue");
+    m_config.recv_batch_size = cfg.getValue("recv_batch_size", 16);
+    m_config.recv_pool_size = cfg.getValue("recv_pool_size", 256);
+    m_config.io_backend = cfg.getValue("io_backend", (std::string) "poll");
+    m_config.uring_entries = cfg.getValue("uring_entries", 256);
+    m_config.uring_buf_count = cfg.getValue("uring_buf_count", 256);
+    m_config.recv_threads = cfg.getValue("recv_threads", 1);
+    m_config.reuseport_cpu_steering = cfg.getValue("reuseport_cpu_steering", false);
+    m_config.udp_gso = cfg.getValue("udp_gso", true);
+    m_config.udp_gro = cfg.getValue("udp_gro", false);
+    m_config.zerocopy_threshold = cfg.getValue("zerocopy_threshold", 16384);
+    m_config.send_cache_size = cfg.getValue("send_cache_size", 64);
+    m_config.send_cache_idle_ms = cfg.getValue("send_cache_idle_ms", 30000);
+    m_config.periodic_spin_us = cfg.getValue("periodic_spin_us", 0);
+    m_config.async_send_queue_size = cfg.getValue("async_send_queue_size", 16384);
+    m_config.async_send_threads = cfg.getValue("async_send_threads", 1);
+    m_config.async_send_batch = cfg.getValue("async_send_batch", 64);
+    m_config.async_send_full_policy = cfg.getValue("async_send_full_policy", (std::string) "reject");
+    m_config.udp_fragment = cfg.getValue("udp_fragment", false);
+    m_config.fragment_timeout_ms = cfg.getValue("fragment_timeout_ms", 1000);
+    m_config.fragment_max_message_size = cfg.getValue("fragment_max_message_size", 1048576);
+    m_config.fragment_max_pending_bytes = cfg.getValue("fragment_max_pending_bytes", 16777216);
+    m_config.fragment_checksum = cfg.getValue("fragment_checksum", (std::string) "none");
+#ifdef DUAL_ENDPOINT_MODE
+    pimpl_->initFragmentChecksum();
+#else
+    if (m_config.udp_fragment)
+    {
+        LOG_WARNING("udp_fragment requires DUAL_ENDPOINT_MODE build, ignored");
+        m_config.udp_fragment = false;
+    }
+#endif
 
-    LOG_DEBUG("Configuration loaded - max_send: {}, max_recv: {}, send_timeout: {}ms, recv_timeout: {}ms, source_addr: {}:{}, thread_pool: {}",
+    LOG_DEBUG("Configuration loaded - max_send: {}, max_recv: {}, send_timeout: {}ms, recv_timeout: {}ms, source_addr: {}:{}, thread_pool: {}, recv_batch: {}, recv_threads: {}",
               m_config.max_send_packet_size, m_config.max_receive_packet_size,
               m_config.send_timeout_ms, m_config.recv_timeout_ms,
               m_config.source_addr.source_ip, m_config.source_addr.source_port,
-              m_config.thread_pool_size);
+              m_config.thread_pool_size, m_config.recv_batch_size, m_config.recv_threads);
+
+    pimpl_->setRecvShards(m_config.recv_threads);
+#ifdef __linux__
+    pimpl_->initGso();
+#endif
 
 #ifdef THREAD_POOL_MODE
     // 创建线程池
-    s_thread_pool_ = std::make_unique<ThreadPoolWrapper>(m_config.thread_pool_size);
-    LOG_DEBUG("Created thread pool with size: {}", m_config.thread_pool_size);
+    s_thread_pool_ = std::make_unique<ThreadPoolWrapper>(m_config.thread_pool_size, 1024,
+        m_config.thread_pool_scheduler == "work_stealing" ? ThreadPoolWrapper::Scheduler::WorkStealing
+                                                          : ThreadPoolWrapper::Scheduler::GlobalQueue);
+    LOG_DEBUG("Created thread pool with size: {}, scheduler: {}", m_config.thread_pool_size, m_config.thread_pool_scheduler);
 #endif
 
+    if (m_config.io_backend == "io_uring")
+    {
+#ifdef IO_URING_MODE
+        pimpl_->initUringSend();
+#else
+        LOG_WARNING("io_backend io_uring requested but library built without IO_URING_MODE, using poll");
+#endif
+    }
+
     // 获得需要监听的端口列表
     auto listen_list = cfg.getList<ConfigInterface::CommInfo>("listen_list");
     for (const auto &item : listen_list)
@@ -625,6 +2119,45 @@ bool UdpCommunicateCore::send(const std::string &dest_addr, int dest_port,
     return pimpl_->sendDataWithPool(dest_addr, dest_port, data, size);
 }
 
+bool UdpCommunicateCore::sendv(const std::string &dest_addr, int dest_port,
+                               const communicate::iovec *iov, int iovcnt)
+{
+    return pimpl_->sendvWithPool(dest_addr, dest_port, iov, static_cast<size_t>(iovcnt));
+}
+
+bool UdpCommunicateCore::sendOwned(const std::string &dest_addr, int dest_port,
+                                   std::shared_ptr<const void> data, size_t size)
+{
+    return pimpl_->sendDataWithPool(dest_addr, dest_port, data.get(), size, data);
+}
+
+std::shared_ptr<const CommunicateInterface::EndpointHandle> UdpCommunicateCore::resolveEndpoint(
+    const std::string &addr, int port)
+{
+    return pimpl_->resolveEndpoint(addr, port);
+}
+
+bool UdpCommunicateCore::sendTo(const EndpointHandle &endpoint, const void *data, size_t size)
+{
+    return pimpl_->sendToEndpoint(endpoint, data, size);
+}
+
+bool UdpCommunicateCore::sendOwnedTo(const EndpointHandle &endpoint, std::shared_ptr<const void> data, size_t size)
+{
+    return pimpl_->sendToEndpoint(endpoint, data.get(), size, data);
+}
+
+int UdpCommunicateCore::sendBurst(const std::vector<OutgoingMessage> &messages, std::vector<bool> *results)
+{
+    return pimpl_->sendBurst(messages, results);
+}
+
+int UdpCommunicateCore::sendBatch(const std::vector<std::pair<std::string, int>> &dest_list,
+                                  const void *data, size_t size, std::vector<bool> *results)
+{
+    return pimpl_->sendBatchWithPool(dest_list, data, size, results);
+}
+
 int UdpCommunicateCore::addListenAddr(const char *addr, int port)
 {
     std::string addr_str(addr ? addr : "");
@@ -640,13 +2173,27 @@ int UdpCommunicateCore::addListenAddr(const char *addr, int port)
 int UdpCommunicateCore::addSubscribe(const char *addr, int port, communicate::SubscribebBase *sub)
 {
     std::string addr_str(addr ? addr : "");
-    std::string key = UdpCommunicateCore::Impl::createSubKey(addr_str, port);
-    LOG_DEBUG("Adding subscriber for key: {}", key);
-    pimpl_->addSubscriber(key, sub);
+    if (!pimpl_->addSubscriber(addr_str, port, sub))
+        return -1;
     pimpl_->start();
     return 0;
 }
 
+void UdpCommunicateCore::setDatagramHandler(DatagramHandler handler)
+{
+    pimpl_->setDatagramHandler(std::move(handler));
+}
+
+void UdpCommunicateCore::startReceiving()
+{
+    pimpl_->start();
+}
+
+SocketType UdpCommunicateCore::listenSocket(uint16_t local_port) const
+{
+    return pimpl_->listenSocket(local_port);
+}
+
 void UdpCommunicateCore::shutdown()
 {
     LOG_INFO("Shutting down UDP communication core");
@@ -658,4 +2205,11 @@ void UdpCommunicateCore::setDefSource(int port, std::string ip)
     LOG_DEBUG("Setting source addr to {}:{}", ip, port);
     m_config.source_addr.source_port = port;
     m_config.source_addr.source_ip = ip;
+    // 缓存的socket按旧源地址绑定，之后按新配置重新创建
+    pimpl_->clearSendCache();
+}
+
+UdpCommunicateCore::SendCacheStats UdpCommunicateCore::sendCacheStats() const
+{
+    return pimpl_->sendCacheStats();
 }
\ No newline at end of file
@@ -16,8 +16,11 @@ Version history
 #define UDP_CORE_H_
 
 #include "../communicate_interface.h"
+#include "../subscriber_router.h"
+#include "../zerocopy_tracker.h"
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -38,6 +41,12 @@ Version history
 #include <unistd.h>
 #include <fcntl.h>
 #include <poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <linux/filter.h>
+#include <netinet/udp.h>
+#endif
     typedef int SocketType;
 #define INVALID_SOCKET (-1)
 #define SOCKET_ERROR (-1)
@@ -46,7 +55,12 @@ Version history
 #ifdef THREAD_POOL_MODE
 #include "threadpool_wrapper.h"
 #endif
+#ifdef IO_URING_MODE
+#include "uring_engine.h"
+#endif
 #include "common/config_wrapper.h"
+#include "utils/buffer_pool.h"
+#include "utils/rcu_snapshot.h"
 
 /**
  * @brief UDP核心通信类
@@ -63,6 +77,19 @@ public:
 
     int initialize() override;
     bool send(const std::string &dest_addr, int dest_port, const void *data, size_t size) override;
+    // 多段数据按拼接后的整体分片，经 sendmsg/sendmmsg 直接发送各段（非Linux平台先拼接）
+    bool sendv(const std::string &dest_addr, int dest_port, const communicate::iovec *iov, int iovcnt) override;
+    // 经连接池中的发送socket且超过 zerocopy_threshold 时以 MSG_ZEROCOPY 发送，data 保持至内核完成通知
+    bool sendOwned(const std::string &dest_addr, int dest_port, std::shared_ptr<const void> data, size_t size) override;
+    // 所有目标及分片通过 sendmmsg 批量发送（非Linux平台逐条 sendto）
+    int sendBatch(const std::vector<std::pair<std::string, int>> &dest_list,
+                  const void *data, size_t size, std::vector<bool> *results = nullptr) override;
+    // 目标地址只解析一次；不在 send_list 中的目标由句柄独占一个发送socket
+    std::shared_ptr<const EndpointHandle> resolveEndpoint(const std::string &addr, int port) override;
+    bool sendTo(const EndpointHandle &endpoint, const void *data, size_t size) override;
+    bool sendOwnedTo(const EndpointHandle &endpoint, std::shared_ptr<const void> data, size_t size) override;
+    // 单个数据报即可发完的消息按发送socket分组，每组一次 sendmmsg（非Linux平台及其余消息逐条发送）
+    int sendBurst(const std::vector<OutgoingMessage> &messages, std::vector<bool> *results = nullptr) override;
     int addListenAddr(const char* addr, int port) override;
     int addSubscribe(const char *addr, int port, communicate::SubscribebBase *sub) override;
     void shutdown() override;
@@ -70,6 +97,16 @@ public:
     // 修改发送使用的端口和地址
     void setDefSource(int port, std::string source_ip = "") override;
 
+    // 不在 send_list 中的目标的发送socket缓存统计
+    struct SendCacheStats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;     // 因容量或空闲超时关闭的socket数
+        size_t size = 0;            // 当前缓存的socket数
+    };
+    SendCacheStats sendCacheStats() const;
+
 protected:
     // 配置参数结构体
     struct CoreConfig
@@ -80,12 +117,46 @@ protected:
         int max_receive_packet_size = 65507;// 最大包大小（IP 层限制（65535 字节） - IP/UDP 头（28 字节）​​ ≈ ​​65507 字节）
         LocalSourceAddr source_addr;        // 发送源地址，port 0表示系统自动分配，ip 为空使用默认网卡
         size_t thread_pool_size = 3;        // 线程池大小配置
+        std::string thread_pool_scheduler = "queue";    // 线程池调度方式：queue（共用任务队列）/ work_stealing（任务窃取），需THREAD_POOL_MODE编译
+        int recv_batch_size = 16;           // 单次唤醒每个socket最多批量接收的数据包数（recvmmsg，<=1 时逐包接收，仅Linux有效）
+        int recv_pool_size = 256;           // 接收缓冲池最多缓存的空闲缓冲数（每个缓冲 max_receive_packet_size 字节）
+        std::string io_backend = "poll";    // 收发后端：poll（Linux下为epoll） / io_uring（需IO_URING_MODE编译，内核不支持时自动回退）
+        int uring_entries = 256;            // io_uring 提交队列深度
+        int uring_buf_count = 256;          // io_uring 接收提供缓冲数量（2的幂，每个缓冲约 max_receive_packet_size 字节）
+        int recv_threads = 1;               // 接收线程（分片）数，>1 时每个监听地址以 SO_REUSEPORT 打开多份（仅Linux有效）
+        bool reuseport_cpu_steering = false;// 多分片时按接收数据包的CPU号选择分片（SO_ATTACH_REUSEPORT_CBPF）
+        bool udp_gso = true;                // 超过 max_send_packet_size 的消息整段交给内核切分（UDP_SEGMENT，仅Linux，不支持时自动回退）
+        bool udp_gro = false;               // 接收时由内核合并同一流的连续数据报，按段长拆分后交给订阅者（UDP_GRO，仅Linux）
+        int zerocopy_threshold = 16384;     // 转移所有权发送的数据不小于该值时使用 MSG_ZEROCOPY（仅Linux），0 为不启用
+        int send_cache_size = 64;           // 不在 send_list 中的目标按地址缓存的发送socket上限（LRU淘汰），0 为每次发送创建临时socket
+        int send_cache_idle_ms = 30000;     // 缓存的发送socket空闲超过该时长后关闭，<=0 为不按空闲时间淘汰
+        int periodic_spin_us = 0;           // 周期发送在截止时刻前忙等的微秒数（降低高频任务的抖动，占用调度线程CPU），0 为不忙等
+        int async_send_queue_size = 16384;  // 异步发送的在途请求上限（向上取整为2的幂）
+        int async_send_threads = 1;         // 异步发送线程数
+        int async_send_batch = 64;          // 异步发送线程每次最多取出并一并发送（sendmmsg）的请求数
+        std::string async_send_full_policy = "reject";  // 在途请求达到上限时：reject 立即失败 / block 阻塞等待空位
+        bool udp_fragment = false;          // 每个数据报携带分片头，接收端将大消息重组后整条交给订阅者（需DUAL_ENDPOINT_MODE编译，收发两端须一致）
+        int fragment_timeout_ms = 1000;     // 未收齐分片的消息自首个分片到达起的等待时长
+        int fragment_max_message_size = 1048576;    // 可重组的最大消息长度
+        int fragment_max_pending_bytes = 16777216;  // 每个接收线程未完成消息占用的重组缓冲上限，超出时丢弃最早的消息
+        std::string fragment_checksum = "none";     // 分片校验算法：none / crc32 / crc32c（按CPU能力使用硬件加速），接收端按分片头中的算法校验
     } m_config;
 
 #ifdef THREAD_POOL_MODE
     static std::unique_ptr<ThreadPoolWrapper> s_thread_pool_;
 #endif
 
+    /* 供在UDP监听socket上承载其他协议的派生类使用 */
+    // 原始数据报处理：sub 为路由结果（可能为空），src_key/local_key 同 SubscriberRouter 的端点键，在接收线程内调用
+    using DatagramHandler = std::function<void(communicate::SubscribebBase *sub, uint64_t src_key, uint64_t local_key,
+                                               const std::shared_ptr<void> &data, size_t len)>;
+    // 设置后接收到的数据报不再交给订阅者，须在开始接收前设置
+    void setDatagramHandler(DatagramHandler handler);
+    // 未添加订阅者时也启动接收线程
+    void startReceiving();
+    // 绑定在 local_port 上的监听socket（0 为任一个），不存在时返回 INVALID_SOCKET
+    SocketType listenSocket(uint16_t local_port = 0) const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> pimpl_;
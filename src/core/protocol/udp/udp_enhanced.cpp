@@ -1,11 +1,10 @@
 #include "udp_enhanced.h"
 
-#include <chrono>
 #include <cstring>
-#include <thread>
 #include <vector>
 
 UdpCommunicateEnhanced::UdpCommunicateEnhanced()
+    : scheduler_(std::make_unique<PeriodicScheduler>(*this))
 {
     LOG_TRACE("UdpCommunicateEnhanced constructor");
 }
@@ -13,18 +12,36 @@ UdpCommunicateEnhanced::UdpCommunicateEnhanced()
 UdpCommunicateEnhanced::~UdpCommunicateEnhanced()
 {
     LOG_INFO("Shutting down UdpCommunicateEnhanced and stopping all periodic tasks");
-    std::lock_guard<std::mutex> lock(task_mutex_);
-    for (auto &task : periodic_tasks_)
+    // 调度线程经本对象发送，须在基类析构前停止
+    scheduler_->stop();
+    LOG_INFO("All periodic tasks stopped");
+    // 发送线程同样经本对象发送，先发完已入队的请求
+    engine_.reset();
+}
+
+int UdpCommunicateEnhanced::initialize()
+{
+    int ret = UdpCommunicateCore::initialize();
+    scheduler_->setSpin(m_config.periodic_spin_us > 0 ? static_cast<uint64_t>(m_config.periodic_spin_us) * 1000 : 0);
+
+    // 重复初始化时先停止旧引擎（发完已入队的请求）
+    engine_.reset();
+    AsyncSendEngine::Options options;
+    options.queue_size = m_config.async_send_queue_size > 0 ? static_cast<size_t>(m_config.async_send_queue_size) : 1;
+    options.threads = m_config.async_send_threads;
+    options.batch_size = m_config.async_send_batch > 0 ? static_cast<size_t>(m_config.async_send_batch) : 1;
+    // 预解析句柄可能各自持有socket，与 send_list 之外目标的socket缓存共用同一上限
+    options.endpoint_cache = m_config.send_cache_size > 0 ? static_cast<size_t>(m_config.send_cache_size) : 0;
+    if (m_config.async_send_full_policy == "block")
     {
-        LOG_DEBUG("Stopping periodic task {}", task.first);
-        task.second.running = false; // 通知所有任务停止
-        if (task.second.thread.joinable())
-        {
-            task.second.thread.join(); // 等待任务线程结束
-            LOG_DEBUG("Periodic task {} stopped", task.first);
-        }
+        options.block_when_full = true;
     }
-    LOG_INFO("All periodic tasks stopped");
+    else if (m_config.async_send_full_policy != "reject")
+    {
+        LOG_WARNING("Unknown async_send_full_policy '{}', using reject", m_config.async_send_full_policy);
+    }
+    engine_ = std::make_unique<AsyncSendEngine>(*this, options);
+    return ret;
 }
 
 std::future<bool> UdpCommunicateEnhanced::sendAsync(const std::string &dest_addr,
@@ -32,44 +49,40 @@ std::future<bool> UdpCommunicateEnhanced::sendAsync(const std::string &dest_addr
                                        const void *data,
                                        size_t size)
 {
-    LOG_DEBUG("Starting async send to {}:{} (size: {})", dest_addr, dest_port, size);
-
-    // 创建线程安全的数据副本
-    std::shared_ptr<std::vector<char>> buffer = std::make_shared<std::vector<char>>(size);
-    memcpy(buffer->data(), data, size);
-    auto promise_ptr = std::make_shared<std::promise<bool>>();
+    LOG_TRACE("Queueing async send to {}:{} (size: {})", dest_addr, dest_port, size);
+
+    // promise 由发送线程在完成回调中兑现并释放
+    auto *promise = new std::promise<bool>();
+    auto future = promise->get_future();
+
+    int ret = engine_ ? engine_->submit(dest_addr, dest_port, data, size,
+                                        [](int result, uint64_t, void *ctx) {
+                                            auto *p = static_cast<std::promise<bool> *>(ctx);
+                                            p->set_value(result == 0);
+                                            delete p;
+                                        },
+                                        promise)
+                      : -2;
+    if (ret != 0)
+    {
+        // 背压：队列已满（reject 策略）或未初始化/已停止时立即以失败完成
+        LOG_DEBUG("Async send to {}:{} rejected: {}", dest_addr, dest_port,
+                    ret == -1 ? "queue full" : "engine not running");
+        promise->set_value(false);
+        delete promise;
+    }
+    return future;
+}
 
-    auto send_task = [this, dest_addr, dest_port, buffer, promise_ptr]()
+int UdpCommunicateEnhanced::sendAsync(const std::string &dest_addr, int dest_port, const void *data, size_t size,
+                                      communicate::SendCompletion callback, void *ctx)
+{
+    if (!engine_)
     {
-        try
-        {
-            LOG_TRACE("Async send thread started for {}:{}", dest_addr, dest_port);
-            bool result = this->send(dest_addr, dest_port, buffer->data(), buffer->size());
-            promise_ptr->set_value(result);
-            LOG_DEBUG("Async send to {}:{} completed", dest_addr, dest_port);
-        }
-        catch (const std::exception& e)
-        {
-            LOG_ERROR("Async send to {}:{} failed: {}", dest_addr, dest_port, e.what());
-            promise_ptr->set_value(false);  // 不进行promise_ptr->set_exception，分析日志
-        }
-        catch (...)
-        {
-            LOG_ERROR("Async send to {}:{} failed with unknown exception", dest_addr, dest_port);
-            promise_ptr->set_value(false);
-        }
-    };
-
-    // 避免竞争条件
-    auto future = promise_ptr->get_future();
-
-#ifdef THREAD_POOL_MODE
-    s_thread_pool_->enqueue(std::move(send_task));
-#else
-    std::thread(std::move(send_task)).detach();
-#endif
-
-    return future;
+        LOG_ERROR("Async send to {}:{} failed: not initialized", dest_addr, dest_port);
+        return -2;
+    }
+    return engine_->submit(dest_addr, dest_port, data, size, callback, ctx);
 }
 
 int UdpCommunicateEnhanced::addPeriodicTask(
@@ -87,6 +100,22 @@ int UdpCommunicateEnhanced::addPeriodicTask(
         LOG_ERROR("Invalid interval {}ms for periodic task", interval_ms);
         return -1; // ERR_INVALID_INTERVAL
     }
+    if (!data_generator)
+    {
+        LOG_ERROR("Invalid data generator for periodic task");
+        return -4; // ERR_INVALID_GENERATOR
+    }
+
+    return addTask(dest_addr, dest_port, appoint_task_id,
+                   [&](int task_id, PeriodicScheduler::EndpointPtr endpoint) {
+                       return scheduler_->add(task_id, static_cast<uint64_t>(interval_ms) * 1000000, 1,
+                                              std::move(endpoint), std::move(data_generator));
+                   });
+}
+
+int UdpCommunicateEnhanced::addTask(const std::string &dest_addr, int dest_port, int appoint_task_id,
+                                    const std::function<bool(int, PeriodicScheduler::EndpointPtr)> &add)
+{
     if (dest_port <= 0 || dest_port > 65535)
     {
         LOG_ERROR("Invalid port {} for periodic task", dest_port);
@@ -97,110 +126,46 @@ int UdpCommunicateEnhanced::addPeriodicTask(
         LOG_ERROR("Empty destination address for periodic task");
         return -3; // ERR_INVALID_ADDRESS
     }
-    if (!data_generator)
+
+    // 目标地址只解析一次，每次发送直接使用解析结果
+    auto endpoint = resolveEndpoint(dest_addr, dest_port);
+    if (!endpoint)
     {
-        LOG_ERROR("Invalid data generator for periodic task");
-        return -4; // ERR_INVALID_GENERATOR
+        LOG_ERROR("Cannot resolve destination {}:{} for periodic task", dest_addr, dest_port);
+        return -3; // ERR_INVALID_ADDRESS
     }
 
     std::lock_guard<std::mutex> lock(task_mutex_);
 
     // 处理指定的任务ID
     int task_id = next_task_id_++;
-    if (appoint_task_id != -1)
-    {
-        if (task_map_.count(appoint_task_id))
-        {
-            LOG_ERROR("Duplicate task ID {} requested", appoint_task_id);
-            return -5; // ERR_DUPLICATE_TASK_ID
-        }
-        task_map_[appoint_task_id] = task_id;
-        LOG_DEBUG("Mapped requested ID {} to internal ID {}", appoint_task_id, task_id);
-    }
-
-    // 预创建任务条目（确保线程安全）
-    auto [it, inserted] = periodic_tasks_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(task_id),
-        std::forward_as_tuple(true, std::thread()));
-
-    if (!inserted)
+    if (appoint_task_id != -1 && task_map_.count(appoint_task_id))
     {
-        LOG_ERROR("Failed to create periodic task entry for ID {}", task_id);
-        return -6; // ERR_TASK_CREATION_FAILED
+        LOG_ERROR("Duplicate task ID {} requested", appoint_task_id);
+        return -5; // ERR_DUPLICATE_TASK_ID
     }
 
-    // 启动任务线程
+    // 登记到调度器（首个任务时创建调度线程）
     try
     {
-        it->second.thread = std::thread([this, task_id, interval_ms,
-                                         dest_addr, dest_port,
-                                         data_generator]() {
-            LOG_DEBUG("Periodic task {} thread started ({}:{} every {}ms)", task_id, dest_addr, dest_port, interval_ms);
-
-            // 安全获取任务对象
-            auto* task = this->getTask(task_id);
-            if (!task || !task->running.load())
-            {
-                LOG_WARNING("Periodic task {} terminated immediately", task_id);
-                return;
-            }
-
-            while (task->running.load())
-            {
-                auto start = std::chrono::steady_clock::now();
-                
-                try
-                {
-                    // 生成并发送数据
-                    auto data = data_generator();
-                    if (!data.empty())
-                    {
-                        LOG_TRACE("Periodic task {} generating data (size: {})", task_id, data.size());
-                        this->send(dest_addr, dest_port, data.data(), data.size());
-                        LOG_TRACE("Periodic task {} sent data", task_id);
-                    }
-                    else
-                    {
-                        LOG_WARNING("Periodic task {} generated empty data", task_id);
-                    }
-                }
-                catch (const std::exception& e)
-                {
-                    // 记录生成器异常
-                    LOG_ERROR("Periodic task {} data generator failed: {}", task_id, e.what());
-                    break;
-                }
-                
-                // 精确控制发送间隔
-                auto end = std::chrono::steady_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-                auto sleep_time = std::chrono::milliseconds(interval_ms) - elapsed;
-
-                if (sleep_time.count() > 0)
-                {
-                    std::this_thread::sleep_for(sleep_time);
-                }
-                else
-                {
-                    // 发送超时警告
-                    LOG_WARNING("Periodic task {} execution took longer than interval ({}ms > {}ms)", task_id, elapsed.count(), interval_ms);
-                }
-            }
-        });
+        if (!add(task_id, std::move(endpoint)))
+        {
+            LOG_ERROR("Failed to create periodic task entry for ID {}", task_id);
+            return -6; // ERR_TASK_CREATION_FAILED
+        }
     }
     catch (const std::exception& e)
     {
-        LOG_ERROR("Failed to create thread for periodic task {}: {}", task_id, e.what());
-        periodic_tasks_.erase(it); // 清理失败的任务条目
-        return -7;                 // ERR_THREAD_CREATION_FAILED
+        LOG_ERROR("Failed to start scheduler for periodic task {}: {}", task_id, e.what());
+        return -7; // ERR_THREAD_CREATION_FAILED
     }
-    catch (...)
+
+    if (appoint_task_id != -1)
     {
-        LOG_ERROR("Failed to create thread for periodic task {}: unknown exception", task_id);
-        periodic_tasks_.erase(it); // 清理失败的任务条目
-        return -7;                 // ERR_THREAD_CREATION_FAILED
+        task_map_[appoint_task_id] = task_id;
+        LOG_DEBUG("Mapped requested ID {} to internal ID {}", appoint_task_id, task_id);
     }
+    LOG_DEBUG("Periodic task {} scheduled to {}:{}", task_id, dest_addr, dest_port);
 
     return 0;
 }
@@ -221,25 +186,29 @@ int UdpCommunicateEnhanced::removePeriodicTask(int appoint_task_id)
     int task_id = map_it->second;
     task_map_.erase(map_it); // 清理映射表
 
-    // 查找并停止任务
-    auto task_it = periodic_tasks_.find(task_id);
-    if (task_it == periodic_tasks_.end())
+    // 删除只做标记，不等待调度线程
+    if (!scheduler_->remove(task_id))
     {
         LOG_WARNING("Internal periodic task {} not found for removal", task_id);
         return -1; // ERR_TASK_NOT_FOUND
     }
-
-    task_it->second.running = false;
-    if (task_it->second.thread.joinable())
-    {
-        task_it->second.thread.join();
-    }
-    periodic_tasks_.erase(task_it);
     LOG_INFO("Periodic task {} removed successfully", task_id);
 
     return 0; // SUCCESS
 }
 
+int UdpCommunicateEnhanced::periodicTaskStats(int appoint_task_id, communicate::PeriodicTaskStats &stats)
+{
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    auto map_it = task_map_.find(appoint_task_id);
+    if (map_it == task_map_.end() || !scheduler_->stats(map_it->second, stats))
+    {
+        LOG_DEBUG("Periodic task {} not found for stats", appoint_task_id);
+        return -1; // ERR_TASK_NOT_FOUND
+    }
+    return 0;
+}
+
 int UdpCommunicateEnhanced::addPeriodicSendTask(const char *addr, int port,
                                                 const void *pData, size_t size,
                                                 int rate, int task_id)
@@ -247,7 +216,7 @@ int UdpCommunicateEnhanced::addPeriodicSendTask(const char *addr, int port,
     LOG_DEBUG("Adding periodic send task to {}:{} at {}Hz (requested ID: {})", addr ? addr : "NULL", port, rate, task_id);
 
     // 参数校验
-    if (rate <= 0 || rate > 1000)
+    if (rate <= 0 || rate > MAX_PERIODIC_RATE)
     {
         LOG_ERROR("Invalid rate {}Hz for periodic send task", rate);
         return -1; // ERR_INVALID_RATE
@@ -258,32 +227,14 @@ int UdpCommunicateEnhanced::addPeriodicSendTask(const char *addr, int port,
         return -2; // ERR_INVALID_DATA
     }
 
-    // 创建数据副本确保生命周期安全
-    std::shared_ptr<std::vector<char>> dataCopy =
-        std::make_shared<std::vector<char>>(size);
-    memcpy(dataCopy->data(), pData, size);
-
-    // 计算间隔时间
-    int interval_ms = 1000 / rate;
-    LOG_TRACE("Calculated interval {}ms for rate {}Hz", interval_ms, rate);
+    // 创建数据副本确保生命周期安全，每次发送共用这一份
+    auto dataCopy = std::make_shared<const std::vector<char>>(static_cast<const char *>(pData),
+                                                              static_cast<const char *>(pData) + size);
 
-    // 创建生成器lambda
-    auto generator = [dataCopy]() -> std::vector<char>
-    {
-        return *dataCopy; // 返回数据副本
-    };
-
-    return addPeriodicTask(interval_ms, addr, port, task_id, generator);
+    // 周期为 1e9 / rate 纳秒，以分数累加，不能整除的频率也没有累积误差
+    return addTask(addr ? addr : "", port, task_id,
+                   [&](int internal_id, PeriodicScheduler::EndpointPtr endpoint) {
+                       return scheduler_->addFixed(internal_id, 1000000000ull, static_cast<uint64_t>(rate),
+                                                   std::move(endpoint), std::move(dataCopy));
+                   });
 }
-
-// 私有辅助函数实现
-UdpCommunicateEnhanced::PeriodicTask *UdpCommunicateEnhanced::getTask(int task_id)
-{
-    std::lock_guard<std::mutex> lock(task_mutex_);
-    auto it = periodic_tasks_.find(task_id);
-    if (it == periodic_tasks_.end())
-    {
-        LOG_DEBUG("Task {} not found in getTask", task_id);
-    }
-    return (it != periodic_tasks_.end()) ? &it->second : nullptr;
-}
\ No newline at end of file
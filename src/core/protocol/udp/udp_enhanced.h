@@ -2,31 +2,34 @@
 Copyright (c) 2022-2030, shisan233@sszc.live.
 SPDX-License-Identifier: MIT 
 File:        udp_enhanced.h
-Version:     1.1
+Version:     1.3
 Author:      cjx
 start date:
 Description: 在UdpCore基础上添加：
-            1. 周期任务管理（线程安全改进版）
-            2. 异步发送（生命周期安全版）
+            1. 周期任务管理（所有任务共用一个时间轮调度线程，同一时刻到期的任务批量发送）
+            2. 异步发送（数据拷入有界无锁队列，由固定的发送线程批量发出；队列满时按配置失败或阻塞）
             3. 地址过滤
             4. 多线程处理模式（增强健壮性）
 Version history
 [序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
 [1.1]    |   [2023-08-20]  |   [cjx]   |   [增强线程安全和异常处理]
+[1.2]    |   [2026-10-17]  |   [cjx]   |   [周期任务改由 PeriodicScheduler 调度，不再每个任务一个线程]
+[1.3]    |   [2026-10-17]  |   [cjx]   |   [异步发送改由 AsyncSendEngine 处理，不再每次发送创建线程]
 *****************************************************************/
 
 #ifndef UDP_ENHANCED_H_
 #define UDP_ENHANCED_H_
 
 #include "udp_core.h"
+#include "../async_send_engine.h"
+#include "../periodic_scheduler.h"
 
 #include <atomic>
 #include <cstring>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
-#include <thread>
-#include <unordered_map>
 
 class UdpCommunicateEnhanced : public UdpCommunicateCore
 {
@@ -34,9 +37,14 @@ public:
     UdpCommunicateEnhanced();
     ~UdpCommunicateEnhanced() override;
 
-    // 异步发送接口（线程安全）
+    int initialize() override;
+
+    // 异步发送接口（线程安全），在途请求达到 async_send_queue_size 且为 reject 策略时返回的 future 立即为 false
     std::future<bool> sendAsync(const std::string &dest_addr, int dest_port,
                                 const void *data, size_t size) override;
+    // 完成回调式异步发送，与上者共用发送线程与队列，回调直接由请求记录携带，不分配 promise
+    int sendAsync(const std::string &dest_addr, int dest_port, const void *data, size_t size,
+                  communicate::SendCompletion callback, void *ctx) override;
 
     // 增强版周期任务接口（带完整错误处理）
     int addPeriodicTask(int interval_ms,
@@ -48,34 +56,24 @@ public:
     // 安全删除周期任务（自动清理资源）
     int removePeriodicTask(int task_id) override;
 
-    // 安全周期发送任务（数据生命周期保障）
+    // 安全周期发送任务（数据生命周期保障），频率上限 MAX_PERIODIC_RATE，周期精确到纳秒
     int addPeriodicSendTask(const char *addr, int port, const void *pData, size_t size, int rate, int task_id = -1) override;
 
-private:
-    // 周期任务结构体（线程安全设计）
-    struct PeriodicTask
-    {
-        std::atomic<bool> running{false}; // 原子操作标志位
-        std::thread thread;               // 任务线程
-
-        PeriodicTask() = default;
+    // 周期任务的调度统计（仅支持添加时指定了ID的任务）
+    int periodicTaskStats(int task_id, communicate::PeriodicTaskStats &stats) override;
 
-        // 移动构造（确保线程对象安全转移）
-        PeriodicTask(PeriodicTask &&other) noexcept
-            : running(other.running.load()),
-              thread(std::move(other.thread)) {}
+    static constexpr int MAX_PERIODIC_RATE = 100000;
 
-        PeriodicTask(bool running, std::thread &&t)
-            : running(running), thread(std::move(t)) {}
-    };
-
-    // 内部获取任务（带锁保护）
-    PeriodicTask *getTask(int task_id);
+private:
+    // 校验目标、分配ID并登记到调度器，add 完成实际登记（周期由调用方传入）
+    int addTask(const std::string &dest_addr, int dest_port, int appoint_task_id,
+                const std::function<bool(int, PeriodicScheduler::EndpointPtr)> &add);
 
     std::atomic<int> next_task_id_{1};                     // 原子任务ID计数器
     std::mutex task_mutex_;                                // 任务管理锁
     std::map<int, int> task_map_;                          // 外部ID到内部ID映射
-    std::unordered_map<int, PeriodicTask> periodic_tasks_; // 任务存储
+    std::unique_ptr<PeriodicScheduler> scheduler_;         // 周期任务调度（调度线程在添加首个任务时创建）
+    std::unique_ptr<AsyncSendEngine> engine_;              // 异步发送（initialize 时按配置创建）
 
     /* 拓展可实现 发向指定地址，或者指定类型的消息使用固定的端口
         std::unordered_map<std::string, int> port_mapping
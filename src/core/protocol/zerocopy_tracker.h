@@ -0,0 +1,240 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        zerocopy_tracker.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: MSG_ZEROCOPY 发送的缓冲生命周期跟踪（仅Linux，UDP/TCP共用）
+    1. 每个socket一个跟踪器，首次零拷贝发送时开启 SO_ZEROCOPY
+    2. 内核为每次成功的零拷贝 sendmsg 分配递增序号，跟踪器按同一顺序保存数据所有者，
+       发送与登记在同一把锁内完成，保证序号一一对应
+    3. 完成通知从错误队列（MSG_ERRQUEUE）读取，按序号区间释放对应的所有者；
+       通知在后续发送时顺带回收，另由收发模块的后台线程定期回收（tryReap）；关闭socket前等待剩余通知
+    4. 内核报告数据实际被拷贝（如回环、网卡不支持分散聚合）后，该socket不再使用零拷贝
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef ZEROCOPY_TRACKER_H_
+#define ZEROCOPY_TRACKER_H_
+
+#ifdef __linux__
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
+class ZeroCopyTracker
+{
+public:
+    // 后台线程定期回收（tryReap）的间隔
+    static constexpr int REAP_INTERVAL_MS = 100;
+
+    explicit ZeroCopyTracker(int fd) : fd_(fd) {}
+
+    ZeroCopyTracker(const ZeroCopyTracker &) = delete;
+    ZeroCopyTracker &operator=(const ZeroCopyTracker &) = delete;
+
+    // 发送与登记需持有该锁（同一socket上的零拷贝发送因此串行）
+    std::mutex &mutex() { return mutex_; }
+
+    // 该socket能否使用零拷贝：内核不支持 SO_ZEROCOPY 或已退化为拷贝时返回false
+    bool usable()
+    {
+        reap();
+        if (state_ == State::UNKNOWN)
+        {
+            int one = 1;
+            state_ = setsockopt(fd_, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0
+                         ? State::ENABLED : State::UNSUPPORTED;
+        }
+        return state_ == State::ENABLED;
+    }
+
+    // 首次出现“内核已拷贝”的通知时返回true（仅一次，供调用方记录日志）
+    bool takeCopiedNotice()
+    {
+        bool notice = copied_notice_;
+        copied_notice_ = false;
+        return notice;
+    }
+
+    /**
+     * @brief 以 MSG_ZEROCOPY 发送一条消息，成功时登记 owner 直至内核完成通知
+     * @return 同 sendmsg；optmem 耗尽（ENOBUFS）时等待已有通知后重试一次
+     */
+    ssize_t sendmsg(const msghdr &msg, int flags, const std::shared_ptr<const void> &owner)
+    {
+        reap();
+        ssize_t ret = ::sendmsg(fd_, &msg, flags | MSG_ZEROCOPY);
+        if (ret < 0 && errno == ENOBUFS && wait(RETRY_WAIT_MS))
+            ret = ::sendmsg(fd_, &msg, flags | MSG_ZEROCOPY);
+        if (ret >= 0)
+            track(owner, 1);
+        return ret;
+    }
+
+    // 批量版本：成功发出的每条消息各占一个序号
+    int sendmmsg(mmsghdr *msgs, unsigned int count, int flags, const std::shared_ptr<const void> &owner)
+    {
+        reap();
+        int sent = ::sendmmsg(fd_, msgs, count, flags | MSG_ZEROCOPY);
+        if (sent < 0 && errno == ENOBUFS && wait(RETRY_WAIT_MS))
+            sent = ::sendmmsg(fd_, msgs, count, flags | MSG_ZEROCOPY);
+        if (sent > 0)
+            track(owner, static_cast<size_t>(sent));
+        return sent;
+    }
+
+    // 非阻塞读取错误队列中的完成通知并释放已完成的缓冲
+    void reap()
+    {
+        while (!pending_.empty())
+        {
+            union
+            {
+                cmsghdr align;
+                char buf[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+            } control;
+            msghdr msg = {};
+            msg.msg_control = control.buf;
+            msg.msg_controllen = sizeof(control.buf);
+            if (recvmsg(fd_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+                return;
+
+            for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+            {
+                bool recverr = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                               (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+                if (!recverr)
+                    continue;
+                sock_extended_err err;
+                memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+                if (err.ee_origin != SO_EE_ORIGIN_ZEROCOPY || err.ee_errno != 0)
+                    continue;
+                if ((err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) && state_ == State::ENABLED)
+                {
+                    state_ = State::COPIED;
+                    copied_notice_ = true;
+                }
+                complete(err.ee_info, err.ee_data);
+            }
+        }
+    }
+
+    // 等待已登记的发送全部完成，超时返回false
+    bool wait(int timeout_ms)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        reap();
+        while (!pending_.empty())
+        {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0)
+                return false;
+
+            // 错误队列非空时 poll 报告 POLLERR
+            pollfd pfd = {fd_, 0, 0};
+            if (poll(&pfd, 1, static_cast<int>(remaining)) <= 0)
+                return false;
+            size_t before = pending_.size();
+            reap();
+            if (pending_.size() == before && !(pfd.revents & POLLERR))
+                return false;
+        }
+        return true;
+    }
+
+    // 未完成的发送数，无需持有锁即可读取（供定期回收判断）
+    size_t pending() const { return pending_count_.load(std::memory_order_relaxed); }
+
+    // 定期回收：有未完成的发送时读取完成通知；发送方正持有锁时跳过，其发送前会顺带回收
+    void tryReap()
+    {
+        if (pending() == 0)
+            return;
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (lock.owns_lock())
+            reap();
+    }
+
+private:
+    static constexpr int RETRY_WAIT_MS = 100;
+
+    enum class State
+    {
+        UNKNOWN,        // 尚未开启 SO_ZEROCOPY
+        ENABLED,
+        UNSUPPORTED,    // 内核不支持
+        COPIED,         // 内核对该socket的发送退化为拷贝，零拷贝只剩额外开销
+    };
+
+    void track(const std::shared_ptr<const void> &owner, size_t count)
+    {
+        pending_.insert(pending_.end(), count, owner);
+        pending_count_.store(pending_.size(), std::memory_order_relaxed);
+    }
+
+    // 释放序号区间 [lo, hi]（32位回绕）内的所有者，再从队首弹出已完成的连续部分
+    void complete(uint32_t lo, uint32_t hi)
+    {
+        for (uint32_t id = lo;; ++id)
+        {
+            uint32_t index = id - base_id_;
+            if (index < pending_.size())
+                pending_[index].reset();
+            if (id == hi)
+                break;
+        }
+        while (!pending_.empty() && !pending_.front())
+        {
+            pending_.pop_front();
+            ++base_id_;
+        }
+        pending_count_.store(pending_.size(), std::memory_order_relaxed);
+    }
+
+    const int fd_;
+    State state_ = State::UNKNOWN;
+    bool copied_notice_ = false;
+    uint32_t base_id_ = 0;                                  // pending_ 队首对应的内核序号
+    std::deque<std::shared_ptr<const void>> pending_;       // 按序号保存未完成发送的数据所有者
+    std::atomic<size_t> pending_count_{0};                  // pending_ 的长度
+    std::mutex mutex_;
+};
+
+#else
+
+// 非Linux平台不支持零拷贝发送，仅保留声明
+class ZeroCopyTracker;
+
+#endif // __linux__
+
+#endif // ZEROCOPY_TRACKER_H_
@@ -0,0 +1,139 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        buffer_pool.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 固定大小接收缓冲池
+    1. 内核直接写入池中缓冲，再以 shared_ptr 形式交给订阅者，中间无拷贝
+    2. shared_ptr 的控制块构造在缓冲头部预留区域内，不额外申请内存
+    3. 最后一个引用释放后缓冲自动归还缓冲池，空闲缓冲超过上限时才真正释放
+    订阅者持有的缓冲可晚于缓冲池所有者析构（缓冲池由未归还的缓冲共同持有）
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef BUFFER_POOL_H_
+#define BUFFER_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+class BufferPool : public std::enable_shared_from_this<BufferPool>
+{
+public:
+    // block_size 为每个缓冲可用的数据大小，max_cached 为最多缓存的空闲缓冲数
+    static std::shared_ptr<BufferPool> create(size_t block_size, size_t max_cached)
+    {
+        return std::shared_ptr<BufferPool>(new BufferPool(block_size, max_cached));
+    }
+
+    ~BufferPool()
+    {
+        for (char *raw : free_list_)
+        {
+            ::operator delete(raw);
+        }
+    }
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    size_t blockSize() const { return block_size_; }
+
+    // 取出一个缓冲（返回数据区起始地址）
+    char *acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_list_.empty())
+            {
+                char *raw = free_list_.back();
+                free_list_.pop_back();
+                return raw + HEADER_SIZE;
+            }
+        }
+        return static_cast<char *>(::operator new(HEADER_SIZE + block_size_)) + HEADER_SIZE;
+    }
+
+    // 归还未交给订阅者的缓冲
+    void release(char *data)
+    {
+        char *raw = data - HEADER_SIZE;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (free_list_.size() < max_cached_)
+            {
+                free_list_.push_back(raw);
+                return;
+            }
+        }
+        ::operator delete(raw);
+    }
+
+    /**
+     * @brief 将缓冲交给 shared_ptr 管理，最后一个引用释放后自动归还
+     * @param data      acquire 得到的缓冲
+     * @param payload   shared_ptr 指向的地址（缓冲内有效数据起始位置），为空时即 data
+     */
+    std::shared_ptr<void> share(char *data, void *payload = nullptr)
+    {
+        return std::shared_ptr<void>(payload ? payload : data, [](void *) {},
+                                     BlockAllocator<char>{data, shared_from_this()});
+    }
+
+private:
+    // 缓冲头部为 shared_ptr 控制块预留的空间
+    static constexpr size_t HEADER_SIZE = 128;
+
+    BufferPool(size_t block_size, size_t max_cached)
+        : block_size_(block_size), max_cached_(max_cached) {}
+
+    // 控制块分配器：控制块放在缓冲头部，控制块释放时（晚于所有引用）将缓冲归还缓冲池
+    template <typename T>
+    struct BlockAllocator
+    {
+        using value_type = T;
+
+        char *data;
+        std::shared_ptr<BufferPool> pool;
+
+        BlockAllocator(char *d, std::shared_ptr<BufferPool> p) : data(d), pool(std::move(p)) {}
+        template <typename U>
+        BlockAllocator(const BlockAllocator<U> &other) : data(other.data), pool(other.pool) {}
+
+        T *allocate(size_t n)
+        {
+            if (n * sizeof(T) <= HEADER_SIZE && alignof(T) <= alignof(std::max_align_t))
+                return reinterpret_cast<T *>(data - HEADER_SIZE);
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t)
+        {
+            if (reinterpret_cast<char *>(p) != data - HEADER_SIZE)
+            {
+                ::operator delete(p);
+            }
+            pool->release(data);
+        }
+
+        template <typename U>
+        bool operator==(const BlockAllocator<U> &other) const { return data == other.data; }
+        template <typename U>
+        bool operator!=(const BlockAllocator<U> &other) const { return data != other.data; }
+    };
+
+    const size_t block_size_;
+    const size_t max_cached_;
+    std::mutex mutex_;
+    std::vector<char *> free_list_;
+};
+
+#endif // BUFFER_POOL_H_
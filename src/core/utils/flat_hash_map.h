@@ -0,0 +1,175 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        flat_hash_map.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 开放寻址哈希表（线性探测）
+    1. 键值连续存放在单个数组中，查找只访问相邻槽位，没有逐节点分配
+    2. 容量为2的幂，负载超过一半时翻倍；哈希值再经乘法混合取高位，std::hash 为恒等映射的整数键也能分布均匀
+    3. 删除采用后移（backward shift），不留墓碑，长期增删后查找长度不退化
+    Value 需可默认构造；插入或删除后此前取得的指针失效；非线程安全
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef FLAT_HASH_MAP_H_
+#define FLAT_HASH_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class FlatHashMap
+{
+public:
+    explicit FlatHashMap(size_t capacity = 16) { rehash(roundUp(capacity * 2)); }
+
+    Value *find(const Key &key)
+    {
+        for (size_t i = home(key);; i = (i + 1) & mask_)
+        {
+            Slot &slot = slots_[i];
+            if (!slot.used)
+                return nullptr;
+            if (equal_(slot.key, key))
+                return &slot.value;
+        }
+    }
+
+    const Value *find(const Key &key) const
+    {
+        return const_cast<FlatHashMap *>(this)->find(key);
+    }
+
+    // 键不存在时插入 value；返回表内的值及是否新插入
+    template <typename V>
+    std::pair<Value *, bool> emplace(const Key &key, V &&value)
+    {
+        if ((size_ + 1) * 2 > slots_.size())
+            rehash(slots_.size() * 2);
+        for (size_t i = home(key);; i = (i + 1) & mask_)
+        {
+            Slot &slot = slots_[i];
+            if (!slot.used)
+            {
+                slot.key = key;
+                slot.value = std::forward<V>(value);
+                slot.used = true;
+                ++size_;
+                return {&slot.value, true};
+            }
+            if (equal_(slot.key, key))
+                return {&slot.value, false};
+        }
+    }
+
+    // 不存在时插入默认值
+    Value &operator[](const Key &key) { return *emplace(key, Value()).first; }
+
+    bool erase(const Key &key)
+    {
+        size_t i = home(key);
+        for (;; i = (i + 1) & mask_)
+        {
+            if (!slots_[i].used)
+                return false;
+            if (equal_(slots_[i].key, key))
+                break;
+        }
+
+        // 把后续同一探测链上的元素前移填补空位
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask_; slots_[j].used; j = (j + 1) & mask_)
+        {
+            size_t ideal = home(slots_[j].key);
+            // ideal 不在 (hole, j] 循环区间内时，j 处元素可移到 hole
+            if (((j - ideal) & mask_) >= ((j - hole) & mask_))
+            {
+                slots_[hole].key = std::move(slots_[j].key);
+                slots_[hole].value = std::move(slots_[j].value);
+                hole = j;
+            }
+        }
+        slots_[hole].key = Key();
+        slots_[hole].value = Value();
+        slots_[hole].used = false;
+        --size_;
+        return true;
+    }
+
+    // 依次访问所有元素 fn(key, value)，期间不可增删
+    template <typename Fn>
+    void forEach(Fn &&fn)
+    {
+        for (auto &slot : slots_)
+        {
+            if (slot.used)
+                fn(slot.key, slot.value);
+        }
+    }
+
+    void clear()
+    {
+        for (auto &slot : slots_)
+            slot = Slot();
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    struct Slot
+    {
+        Key key = Key();
+        Value value = Value();
+        bool used = false;
+    };
+
+    static size_t roundUp(size_t n)
+    {
+        size_t capacity = 16;
+        while (capacity < n)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    size_t home(const Key &key) const
+    {
+        uint64_t h = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h >> shift_);
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        slots_.resize(capacity);
+        mask_ = capacity - 1;
+        shift_ = 64;
+        for (size_t c = capacity; c > 1; c >>= 1)
+            --shift_;
+        size_ = 0;
+        for (auto &slot : old)
+        {
+            if (slot.used)
+                emplace(slot.key, std::move(slot.value));
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    int shift_ = 64;        // 取乘法混合结果的高 log2(容量) 位
+    size_t size_ = 0;
+    Hash hash_;
+    Equal equal_;
+};
+
+#endif // FLAT_HASH_MAP_H_
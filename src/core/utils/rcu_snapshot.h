@@ -0,0 +1,237 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        rcu_snapshot.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 读多写少数据的不可变快照（read-copy-update）
+    1. 读者经原子指针取得当前快照，不加锁、不等待
+    2. 写者复制当前快照、修改后整体替换发布，写者之间互斥
+    3. 旧快照按纪元（epoch）回收：读者进入时登记当前纪元，
+       只有所有读者都已进入更新的纪元后，旧快照才会在后续写操作中释放
+    读守卫存活期间不可阻塞过久（会推迟旧快照回收，但不影响正确性）
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef RCU_SNAPSHOT_H_
+#define RCU_SNAPSHOT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rcu_detail
+{
+
+// 进程内共享的纪元域，所有快照共用一组读者槽位
+class EpochDomain
+{
+public:
+    static constexpr uint64_t IDLE = UINT64_MAX;
+
+    static EpochDomain &instance()
+    {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // 读者进入（可嵌套，仅最外层登记纪元）
+    void enter()
+    {
+        ThreadState &state = threadState();
+        if (state.depth++ > 0)
+            return;
+        if (!state.slot && !state.claim_failed)
+        {
+            state.slot = claimSlot();
+            state.claim_failed = (state.slot == nullptr);
+        }
+
+        // 登记须先于读取快照指针（均为 seq_cst）
+        if (state.slot)
+            state.slot->epoch.store(epoch_.load());
+        else
+            overflow_readers_.fetch_add(1);     // 槽位耗尽的线程统一计数
+    }
+
+    void leave()
+    {
+        ThreadState &state = threadState();
+        if (--state.depth > 0)
+            return;
+        if (state.slot)
+            state.slot->epoch.store(IDLE, std::memory_order_release);
+        else
+            overflow_readers_.fetch_sub(1, std::memory_order_release);
+    }
+
+    // 写者替换快照后调用，返回旧快照的退休纪元
+    uint64_t retire()
+    {
+        return epoch_.fetch_add(1);
+    }
+
+    // 退休纪元小于该值的旧快照已无读者引用
+    uint64_t safeEpoch() const
+    {
+        if (overflow_readers_.load() > 0)
+            return 0;
+        uint64_t min_epoch = IDLE;
+        for (const auto &slot : slots_)
+        {
+            uint64_t epoch = slot.epoch.load();
+            if (epoch < min_epoch)
+                min_epoch = epoch;
+        }
+        return min_epoch;
+    }
+
+private:
+    static constexpr size_t MAX_READERS = 256;
+
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<uint64_t> epoch{IDLE};
+        std::atomic<bool> in_use{false};
+    };
+
+    // 线程退出时归还槽位
+    struct ThreadState
+    {
+        ReaderSlot *slot = nullptr;
+        int depth = 0;
+        bool claim_failed = false;
+
+        ~ThreadState()
+        {
+            if (slot)
+                slot->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    static ThreadState &threadState()
+    {
+        thread_local ThreadState state;
+        return state;
+    }
+
+    ReaderSlot *claimSlot()
+    {
+        for (auto &slot : slots_)
+        {
+            bool expected = false;
+            if (!slot.in_use.load(std::memory_order_relaxed) &&
+                slot.in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                return &slot;
+        }
+        return nullptr;
+    }
+
+    std::atomic<uint64_t> epoch_{1};
+    std::atomic<int> overflow_readers_{0};
+    ReaderSlot slots_[MAX_READERS];
+};
+
+} // namespace rcu_detail
+
+template <typename T>
+class RcuSnapshot
+{
+public:
+    // 读守卫：存活期间所取快照不会被释放
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(const RcuSnapshot &owner)
+        {
+            rcu_detail::EpochDomain::instance().enter();
+            data_ = owner.current_.load();
+        }
+
+        ~ReadGuard()
+        {
+            if (data_)
+                rcu_detail::EpochDomain::instance().leave();
+        }
+
+        ReadGuard(ReadGuard &&other) noexcept : data_(other.data_) { other.data_ = nullptr; }
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+        ReadGuard &operator=(ReadGuard &&) = delete;
+
+        const T &operator*() const { return *data_; }
+        const T *operator->() const { return data_; }
+
+    private:
+        const T *data_;
+    };
+
+    RcuSnapshot() : current_(new T()) {}
+
+    ~RcuSnapshot()
+    {
+        delete current_.load();
+        for (auto &item : retired_)
+        {
+            delete item.data;
+        }
+    }
+
+    RcuSnapshot(const RcuSnapshot &) = delete;
+    RcuSnapshot &operator=(const RcuSnapshot &) = delete;
+
+    ReadGuard read() const { return ReadGuard(*this); }
+
+    // 每次发布新快照时递增，读者可据此判断缓存的派生数据是否过期
+    uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+    // 复制当前快照，交由 fn 修改后发布
+    template <typename Fn>
+    void update(Fn &&fn)
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        std::unique_ptr<T> next(new T(*current_.load(std::memory_order_relaxed)));
+        fn(*next);
+        publish(next.release());
+    }
+
+private:
+    struct Retired
+    {
+        const T *data;
+        uint64_t epoch;
+    };
+
+    void publish(T *next)
+    {
+        auto &domain = rcu_detail::EpochDomain::instance();
+        const T *old = current_.exchange(next);
+        version_.fetch_add(1, std::memory_order_release);
+        retired_.push_back({old, domain.retire()});
+
+        // 回收已无读者的旧快照，其余留待后续写操作
+        uint64_t safe_epoch = domain.safeEpoch();
+        size_t kept = 0;
+        for (auto &item : retired_)
+        {
+            if (item.epoch < safe_epoch)
+                delete item.data;
+            else
+                retired_[kept++] = item;
+        }
+        retired_.resize(kept);
+    }
+
+    std::atomic<const T *> current_;
+    std::atomic<uint64_t> version_{0};
+    std::mutex write_mutex_;
+    std::vector<Retired> retired_;      // 受 write_mutex_ 保护
+};
+
+#endif // RCU_SNAPSHOT_H_
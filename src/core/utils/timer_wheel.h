@@ -0,0 +1,231 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        timer_wheel.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 分层时间轮（单位为调用方自定的tick，如毫秒）
+    1. 第0层256个槽，每槽1个tick；其上三层各64个槽，每槽跨度为下一层的整圈，
+       覆盖约 2^26 个tick，更远的到期时间按最大跨度处理
+    2. 插入 O(1)；推进时按到期顺序取出元素，低层转完一圈时把上层对应槽的元素下放重新分布
+    3. 每层以位图记录非空槽，推进与查询下次唤醒时刻直接跳过空槽，tick 可以很细（如微秒）
+    4. 不支持取消：调用方在元素内记录有效的到期时间，取出后自行忽略过期条目
+    非线程安全，由调用方加锁
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef TIMER_WHEEL_H_
+#define TIMER_WHEEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+template <typename T>
+class TimerWheel
+{
+public:
+    // now 为当前tick，首次推进从 now 开始处理
+    explicit TimerWheel(uint64_t now = 0) : current_(now) {}
+
+    // 登记 value 在 expire 时到期；早于当前tick的按当前tick处理，返回实际登记的到期tick
+    uint64_t schedule(uint64_t expire, T value)
+    {
+        if (expire < current_)
+            expire = current_;
+        place(Entry{expire, std::move(value)});
+        ++size_;
+        return expire;
+    }
+
+    /**
+     * @brief 推进到 now（含），按到期顺序把到期元素交给 fn(expire, value)
+     * @note fn 内不可再调用本对象（调用方通常先收集再处理）
+     */
+    template <typename Fn>
+    void advance(uint64_t now, Fn &&fn)
+    {
+        while (current_ <= now)
+        {
+            if (size_ == 0)
+            {
+                // 没有元素时直接跳到 now 之后，长时间空闲后无需逐tick空转
+                current_ = now + 1;
+                return;
+            }
+
+            size_t index = current_ & LEVEL0_MASK;
+            if (index == 0)
+            {
+                // 第0层转完一圈，逐层下放，直到某层未回到0号槽
+                for (int level = 1; level < LEVELS; ++level)
+                {
+                    if (cascade(level) != 0)
+                        break;
+                }
+            }
+
+            std::vector<Entry> &slot = level0_[index];
+            if (!slot.empty())
+            {
+                expired_.swap(slot);
+                level0_bits_[index >> 6] &= ~(uint64_t(1) << (index & 63));
+                size_ -= expired_.size();
+                for (auto &entry : expired_)
+                    fn(entry.expire, entry.value);
+                expired_.clear();
+            }
+
+            // 跳过之间没有元素到期、也无需下放的tick
+            ++current_;
+            uint64_t next = nextEvent();
+            if (next > current_)
+                current_ = next < now + 1 ? next : now + 1;
+        }
+    }
+
+    /**
+     * @brief 下一个需要推进的tick（用于决定休眠时长）
+     * @return 最早的到期tick，或更早的上层槽下放时刻（下放后可能仍未到期）；为空时返回 UINT64_MAX
+     */
+    uint64_t nextExpiry() const
+    {
+        return size_ == 0 ? UINT64_MAX : nextEvent();
+    }
+
+    // 下一个待处理的tick
+    uint64_t current() const { return current_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    static constexpr int LEVEL0_BITS = 8;
+    static constexpr int LEVELN_BITS = 6;
+    static constexpr int LEVELS = 4;
+    static constexpr size_t LEVEL0_SLOTS = size_t(1) << LEVEL0_BITS;
+    static constexpr size_t LEVELN_SLOTS = size_t(1) << LEVELN_BITS;
+    static constexpr uint64_t LEVEL0_MASK = LEVEL0_SLOTS - 1;
+    static constexpr uint64_t LEVELN_MASK = LEVELN_SLOTS - 1;
+    static constexpr uint64_t MAX_SPAN = (uint64_t(1) << (LEVEL0_BITS + (LEVELS - 1) * LEVELN_BITS)) - 1;
+
+    struct Entry
+    {
+        uint64_t expire;
+        T value;
+    };
+
+    static constexpr int shift(int level) { return LEVEL0_BITS + (level - 1) * LEVELN_BITS; }
+
+    static int lowestBit(uint64_t word)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    // 在 words 个字的环形位图中从 start 起（含）查找第一个置位，返回与 start 的距离，没有置位时返回 SIZE_MAX
+    static size_t ringDistance(const uint64_t *bits, size_t words, size_t start)
+    {
+        const size_t slots = words * 64;
+        for (size_t scanned = 0; scanned < slots + 64;)
+        {
+            size_t pos = (start + scanned) % slots;
+            uint64_t word = bits[pos >> 6] >> (pos & 63);
+            if (word)
+                return scanned + lowestBit(word);
+            scanned += 64 - (pos & 63);
+        }
+        return SIZE_MAX;
+    }
+
+    // 从 current_ 起最早需要处理的tick：第0层最近的非空槽，或各上层最近一个非空槽的下放时刻
+    uint64_t nextEvent() const
+    {
+        uint64_t best = UINT64_MAX;
+        size_t distance = ringDistance(level0_bits_, LEVEL0_SLOTS / 64, current_ & LEVEL0_MASK);
+        if (distance != SIZE_MAX)
+            best = current_ + distance;
+
+        for (int level = 1; level < LEVELS; ++level)
+        {
+            if (levelN_bits_[level - 1] == 0)
+                continue;
+            // current_ 恰为本层某槽起点时该槽尚待下放，否则当前槽已下放过，从下一个槽找起
+            uint64_t block = current_ >> shift(level);
+            bool at_start = (current_ & ((uint64_t(1) << shift(level)) - 1)) == 0;
+            if (!at_start)
+                ++block;
+            distance = ringDistance(&levelN_bits_[level - 1], 1, block & LEVELN_MASK);
+            uint64_t tick = (block + distance) << shift(level);
+            if (tick < best)
+                best = tick;
+        }
+        return best;
+    }
+
+    void place(Entry &&entry)
+    {
+        uint64_t delta = entry.expire - current_;
+        if (delta > MAX_SPAN)
+        {
+            // 超出覆盖范围：暂按最远位置存放，下放时会重新计算
+            delta = MAX_SPAN;
+        }
+        uint64_t when = current_ + delta;
+
+        if (delta < LEVEL0_SLOTS)
+        {
+            size_t index = when & LEVEL0_MASK;
+            level0_[index].push_back(std::move(entry));
+            level0_bits_[index >> 6] |= uint64_t(1) << (index & 63);
+            return;
+        }
+        for (int level = 1; level < LEVELS; ++level)
+        {
+            if (delta < (uint64_t(1) << (shift(level) + LEVELN_BITS)) || level == LEVELS - 1)
+            {
+                size_t index = (when >> shift(level)) & LEVELN_MASK;
+                levels_[level - 1][index].push_back(std::move(entry));
+                levelN_bits_[level - 1] |= uint64_t(1) << index;
+                return;
+            }
+        }
+    }
+
+    // 把第 level 层当前槽的元素下放，返回该槽序号
+    size_t cascade(int level)
+    {
+        size_t index = (current_ >> shift(level)) & LEVELN_MASK;
+        if (!(levelN_bits_[level - 1] & (uint64_t(1) << index)))
+            return index;
+        std::vector<Entry> moving;
+        moving.swap(levels_[level - 1][index]);
+        levelN_bits_[level - 1] &= ~(uint64_t(1) << index);
+        for (auto &entry : moving)
+            place(std::move(entry));
+        return index;
+    }
+
+    uint64_t current_;
+    size_t size_ = 0;
+    std::vector<Entry> level0_[LEVEL0_SLOTS];
+    std::vector<Entry> levels_[LEVELS - 1][LEVELN_SLOTS];
+    uint64_t level0_bits_[LEVEL0_SLOTS / 64] = {};     // 第0层非空槽位图
+    uint64_t levelN_bits_[LEVELS - 1] = {};            // 上层非空槽位图
+    std::vector<Entry> expired_;    // 复用的到期槽缓冲，避免每tick分配
+};
+
+#endif // TIMER_WHEEL_H_
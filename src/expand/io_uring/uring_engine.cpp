@@ -0,0 +1,303 @@
+#include "uring_engine.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+int uring_setup(unsigned entries, io_uring_params *params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+}
+
+UringEngine::~UringEngine()
+{
+    release();
+}
+
+bool UringEngine::init(unsigned entries)
+{
+    io_uring_params params = {};
+    ring_fd_ = uring_setup(entries, &params);
+    if (ring_fd_ < 0)
+        return false;
+
+    sq_entries_ = params.sq_entries;
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+    {
+        sq_ring_size_ = cq_ring_size_ = (sq_ring_size_ > cq_ring_size_) ? sq_ring_size_ : cq_ring_size_;
+    }
+
+    sq_ptr_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ptr_ == MAP_FAILED)
+    {
+        sq_ptr_ = nullptr;
+        release();
+        return false;
+    }
+
+    if (single_mmap)
+    {
+        cq_ptr_ = sq_ptr_;
+    }
+    else
+    {
+        cq_ptr_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ptr_ == MAP_FAILED)
+        {
+            cq_ptr_ = nullptr;
+            release();
+            return false;
+        }
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        release();
+        return false;
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    char *sq = static_cast<char *>(sq_ptr_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    sqe_tail_ = sqe_submitted_ = *sq_tail_;
+
+    char *cq = static_cast<char *>(cq_ptr_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+}
+
+bool UringEngine::setupBufferRing(uint16_t group_id, unsigned count, unsigned buf_size, char *const *addrs)
+{
+    if (!valid() || count == 0 || (count & (count - 1)) != 0 || count > 32768)
+    {
+        errno = EINVAL;
+        return false;
+    }
+
+    // 缓冲环需页对齐，直接使用匿名映射
+    buf_ring_size_ = count * sizeof(io_uring_buf);
+    void *ring = mmap(nullptr, buf_ring_size_, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (ring == MAP_FAILED)
+        return false;
+    // 注册前先写入一次，确保内核固定的是实际页面而非零页
+    memset(ring, 0, buf_ring_size_);
+
+    io_uring_buf_reg reg = {};
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = count;
+    reg.bgid = group_id;
+    if (uring_register(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+    {
+        int err = errno;
+        munmap(ring, buf_ring_size_);
+        errno = err;
+        return false;
+    }
+
+    buf_ring_ = static_cast<io_uring_buf_ring *>(ring);
+    buf_group_ = group_id;
+    buf_count_ = count;
+    buf_size_ = buf_size;
+    buf_tail_ = 0;
+    buf_addrs_.resize(count);
+    if (!addrs)
+        buffers_.assign(static_cast<size_t>(count) * buf_size, 0);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        buf_addrs_[i] = addrs ? addrs[i] : buffers_.data() + static_cast<size_t>(i) * buf_size;
+        recycleBuffer(static_cast<uint16_t>(i));
+    }
+    return true;
+}
+
+void UringEngine::replaceBuffer(uint16_t bid, char *addr)
+{
+    buf_addrs_[bid] = addr;
+    recycleBuffer(bid);
+}
+
+void UringEngine::recycleBuffer(uint16_t bid)
+{
+    // C++ 下 __DECLARE_FLEX_ARRAY 展开后 bufs 的偏移不为0，按内核布局直接寻址
+    io_uring_buf *bufs = reinterpret_cast<io_uring_buf *>(buf_ring_);
+    io_uring_buf &buf = bufs[buf_tail_ & (buf_count_ - 1)];
+    buf.addr = reinterpret_cast<uint64_t>(buffer(bid));
+    buf.len = buf_size_;
+    buf.bid = bid;
+    ++buf_tail_;
+    __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+}
+
+io_uring_sqe *UringEngine::getSqe()
+{
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sqe_tail_ - head >= sq_entries_)
+    {
+        // 队列已满，先提交已准备的请求
+        if (submit() < 0)
+            return nullptr;
+        head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (sqe_tail_ - head >= sq_entries_)
+            return nullptr;
+    }
+
+    unsigned index = sqe_tail_ & sq_mask_;
+    io_uring_sqe *sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    ++sqe_tail_;
+    return sqe;
+}
+
+bool UringEngine::prepRecvMsgMultishot(int fd, const msghdr *msg, uint64_t user_data)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+        return false;
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(msg);
+    sqe->len = 1;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = buf_group_;
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool UringEngine::prepRecvMultishot(int fd, uint64_t user_data)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+        return false;
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = buf_group_;
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool UringEngine::prepRead(int fd, void *buf, unsigned len, uint64_t user_data)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+        return false;
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = len;
+    sqe->off = static_cast<uint64_t>(-1);   // 使用文件当前偏移（eventfd等）
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool UringEngine::prepSendMsg(int fd, const msghdr *msg, uint64_t user_data)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+        return false;
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(msg);
+    sqe->len = 1;
+    sqe->user_data = user_data;
+    return true;
+}
+
+int UringEngine::submit(unsigned wait_nr)
+{
+    unsigned to_submit = sqe_tail_ - sqe_submitted_;
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+
+    int ret;
+    do
+    {
+        ret = uring_enter(ring_fd_, to_submit, wait_nr, wait_nr ? IORING_ENTER_GETEVENTS : 0);
+    } while (ret < 0 && errno == EINTR && to_submit == 0);
+
+    if (ret < 0)
+        return -errno;
+    sqe_submitted_ += static_cast<unsigned>(ret);
+    return ret;
+}
+
+bool UringEngine::parseRecvMsg(char *buf, int32_t res, const msghdr *msg,
+                               sockaddr **name, char **payload, size_t *payload_len, bool *truncated,
+                               msghdr *control)
+{
+    size_t header_len = sizeof(io_uring_recvmsg_out) + msg->msg_namelen + msg->msg_controllen;
+    if (res < 0 || static_cast<size_t>(res) < header_len)
+        return false;
+
+    auto *out = reinterpret_cast<io_uring_recvmsg_out *>(buf);
+    *name = reinterpret_cast<sockaddr *>(buf + sizeof(io_uring_recvmsg_out));
+    *payload = buf + header_len;
+    *payload_len = static_cast<size_t>(res) - header_len;
+    *truncated = (out->flags & MSG_TRUNC) || out->payloadlen > *payload_len;
+    if (control)
+    {
+        control->msg_control = buf + sizeof(io_uring_recvmsg_out) + msg->msg_namelen;
+        control->msg_controllen = out->controllen;
+    }
+    return true;
+}
+
+void UringEngine::release()
+{
+    // 先关闭ring，内核释放对缓冲环的引用后再解除映射
+    if (ring_fd_ >= 0)
+    {
+        close(ring_fd_);
+        ring_fd_ = -1;
+    }
+    if (buf_ring_)
+    {
+        munmap(buf_ring_, buf_ring_size_);
+        buf_ring_ = nullptr;
+    }
+    if (sqes_)
+    {
+        munmap(sqes_, sqes_size_);
+        sqes_ = nullptr;
+    }
+    if (cq_ptr_ && cq_ptr_ != sq_ptr_)
+        munmap(cq_ptr_, cq_ring_size_);
+    cq_ptr_ = nullptr;
+    if (sq_ptr_)
+    {
+        munmap(sq_ptr_, sq_ring_size_);
+        sq_ptr_ = nullptr;
+    }
+}
@@ -0,0 +1,135 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        uring_engine.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 基于io_uring系统调用的轻量收发引擎（不依赖liburing）
+    1. 提交队列/完成队列的映射与提交
+    2. 注册提供缓冲环（provided buffer ring），配合multishot接收使用
+    3. 内核不支持时 init 返回false，由调用方回退到原有poll/epoll实现
+    非线程安全，单个实例只应由一个线程（或在外部加锁后）使用
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef URING_ENGINE_H_
+#define URING_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+
+class UringEngine
+{
+public:
+    // 单个完成事件
+    struct Completion
+    {
+        uint64_t user_data;
+        int32_t res;
+        uint32_t flags;
+
+        bool hasMore() const { return flags & IORING_CQE_F_MORE; }
+        bool hasBuffer() const { return flags & IORING_CQE_F_BUFFER; }
+        uint16_t bufferId() const { return static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT); }
+    };
+
+    UringEngine() = default;
+    ~UringEngine();
+
+    UringEngine(const UringEngine &) = delete;
+    UringEngine &operator=(const UringEngine &) = delete;
+
+    // 创建并映射队列（entries 为提交队列深度），失败返回false并保留errno
+    bool init(unsigned entries);
+    bool valid() const { return ring_fd_ >= 0; }
+    unsigned sqEntries() const { return sq_entries_; }
+
+    // 注册提供缓冲环（count 需为2的幂），multishot接收由内核从中选择缓冲
+    // addrs 非空时使用调用方提供的 count 个缓冲（每个至少 buf_size 字节），否则内部分配
+    bool setupBufferRing(uint16_t group_id, unsigned count, unsigned buf_size, char *const *addrs = nullptr);
+    char *buffer(uint16_t bid) { return buf_addrs_[bid]; }
+    unsigned bufferSize() const { return buf_size_; }
+    // 数据处理完成后将缓冲归还给内核
+    void recycleBuffer(uint16_t bid);
+    // 原缓冲交由调用方持有，以新缓冲顶替该 bid 归还给内核
+    void replaceBuffer(uint16_t bid, char *addr);
+
+    /* 以下 prep 接口在提交队列满时会先提交已有请求 */
+    // multishot recvmsg（UDP），msg 只需设置 msg_namelen/msg_controllen
+    bool prepRecvMsgMultishot(int fd, const msghdr *msg, uint64_t user_data);
+    // multishot recv（TCP）
+    bool prepRecvMultishot(int fd, uint64_t user_data);
+    bool prepRead(int fd, void *buf, unsigned len, uint64_t user_data);
+    bool prepSendMsg(int fd, const msghdr *msg, uint64_t user_data);
+
+    // 提交已准备的请求，wait_nr>0 时等待至少 wait_nr 个完成事件，返回提交数或-errno
+    int submit(unsigned wait_nr = 0);
+
+    // 依次处理当前所有完成事件，返回处理数量
+    template <typename Func>
+    unsigned drainCompletions(Func &&func)
+    {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+        for (; head != tail; ++head, ++count)
+        {
+            const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+            func(Completion{cqe.user_data, cqe.res, cqe.flags});
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    // 解析multishot recvmsg写入缓冲的内容（io_uring_recvmsg_out + name + control + payload）
+    // control 非空时填入控制数据的位置与长度，可直接用 CMSG_FIRSTHDR 遍历
+    static bool parseRecvMsg(char *buf, int32_t res, const msghdr *msg,
+                             sockaddr **name, char **payload, size_t *payload_len, bool *truncated,
+                             msghdr *control = nullptr);
+
+private:
+    io_uring_sqe *getSqe();
+    void release();
+
+    int ring_fd_ = -1;
+    unsigned sq_entries_ = 0;
+
+    void *sq_ptr_ = nullptr;
+    void *cq_ptr_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    size_t cq_ring_size_ = 0;
+    io_uring_sqe *sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+
+    unsigned *sq_head_ = nullptr;
+    unsigned *sq_tail_ = nullptr;
+    unsigned *sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sqe_tail_ = 0;         // 本地已准备（未必已提交）的队尾
+    unsigned sqe_submitted_ = 0;    // 已发布给内核的队尾
+
+    unsigned *cq_head_ = nullptr;
+    unsigned *cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe *cqes_ = nullptr;
+
+    // 提供缓冲环
+    io_uring_buf_ring *buf_ring_ = nullptr;
+    size_t buf_ring_size_ = 0;
+    uint16_t buf_group_ = 0;
+    unsigned buf_count_ = 0;
+    unsigned buf_size_ = 0;
+    unsigned short buf_tail_ = 0;
+    std::vector<char> buffers_;         // 内部分配的缓冲（调用方未提供时）
+    std::vector<char *> buf_addrs_;     // bid -> 缓冲地址
+};
+
+#endif // URING_ENGINE_H_
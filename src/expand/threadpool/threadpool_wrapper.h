@@ -5,6 +5,7 @@
 #else
 #include "threadpool.h"
 #endif
+#include "work_stealing_executor.h"
 
 #include <functional>
 #include <memory>
@@ -15,8 +16,23 @@ public:
 // 封装任务类型为 std::function
     using Task = std::function<void()>;
 
-    explicit ThreadPoolWrapper(size_t threads, size_t task_queue_size = 1024)
+    // 调度方式
+    enum class Scheduler
     {
+        GlobalQueue,    // 所有线程共用一个加锁的任务队列（threadpool_create）
+        WorkStealing,   // 每线程双端队列 + 全局注入队列，空闲线程窃取任务（WorkStealingExecutor）
+    };
+
+    explicit ThreadPoolWrapper(size_t threads, size_t task_queue_size = 1024,
+                               Scheduler scheduler = Scheduler::GlobalQueue)
+    {
+        if (scheduler == Scheduler::WorkStealing)
+        {
+            // 任务队列无界，task_queue_size 不使用
+            executor_ = std::make_unique<WorkStealingExecutor>(threads);
+            return;
+        }
+
         // 创建任务队列，linkoff设置为0因为我们使用独立的任务结构
         taskqueue_ = taskqueue_create(task_queue_size, 0);
         if (!taskqueue_)
@@ -38,6 +54,9 @@ public:
 
     ~ThreadPoolWrapper()
     {
+        if (executor_)
+            return;     // executor_ 析构时停止线程
+
         // 先停止接收新任务
         taskqueue_set_nonblock(taskqueue_);
 
@@ -50,6 +69,13 @@ public:
 
     void enqueue(Task task)
     {
+        if (executor_)
+        {
+            if (!executor_->submit(std::move(task)))
+                throw std::runtime_error("Failed to enqueue task");
+            return;
+        }
+
         // 分配任务内存
         auto *entry = new TaskEntry{std::move(task)};
 
@@ -78,7 +104,7 @@ public:
 
     size_t threadCount() const
     {
-        return pool_->nthreads;
+        return executor_ ? executor_->threadCount() : pool_->nthreads;
     }
 
     // 禁用拷贝和移动
@@ -93,4 +119,5 @@ private:
 
     threadpool_t *pool_ = nullptr;
     taskqueue_t *taskqueue_ = nullptr;
+    std::unique_ptr<WorkStealingExecutor> executor_;
 };
\ No newline at end of file
@@ -0,0 +1,325 @@
+#include "work_stealing_executor.h"
+
+#include <algorithm>
+
+namespace
+{
+    // 当前线程所属的线程池及其工作线程序号（非工作线程为空）
+    thread_local WorkStealingExecutor *t_executor = nullptr;
+    thread_local size_t t_index = 0;
+}
+
+///////////*//////////     Chase–Lev 双端队列    //////////*///////////
+
+WorkStealingExecutor::WorkDeque::Buffer::Buffer(int64_t cap)
+    : capacity(cap), slots(new std::atomic<TaskEntry *>[cap])
+{
+    for (int64_t i = 0; i < cap; ++i)
+        slots[i].store(nullptr, std::memory_order_relaxed);
+}
+
+WorkStealingExecutor::WorkDeque::WorkDeque()
+    : buffer_(new Buffer(256))
+{
+}
+
+WorkStealingExecutor::WorkDeque::~WorkDeque()
+{
+    delete buffer_.load(std::memory_order_relaxed);
+}
+
+void WorkStealingExecutor::WorkDeque::push(TaskEntry *entry)
+{
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Buffer *buffer = buffer_.load(std::memory_order_relaxed);
+    if (b - t > buffer->capacity - 1)
+        buffer = grow(buffer, b, t);
+    buffer->put(b, entry);
+    // 以 release 发布 bottom，窃取线程读到新的 bottom 时一定能看到槽位及任务内容
+    bottom_.store(b + 1, std::memory_order_release);
+}
+
+WorkStealingExecutor::TaskEntry *WorkStealingExecutor::WorkDeque::take()
+{
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer *buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    // 先公开 bottom 的减少再读取 top，与窃取线程的"先读 top 再读 bottom"构成全序
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b)
+    {
+        // 队列为空
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    TaskEntry *entry = buffer->get(b);
+    if (t == b)
+    {
+        // 仅剩一个任务，与窃取线程竞争
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            entry = nullptr;
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return entry;
+}
+
+WorkStealingExecutor::TaskEntry *WorkStealingExecutor::WorkDeque::steal()
+{
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b)
+        return nullptr;
+
+    Buffer *buffer = buffer_.load(std::memory_order_acquire);
+    TaskEntry *entry = buffer->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+    return entry;
+}
+
+bool WorkStealingExecutor::WorkDeque::empty() const
+{
+    int64_t t = top_.load();
+    int64_t b = bottom_.load();
+    return b <= t;
+}
+
+WorkStealingExecutor::WorkDeque::Buffer *WorkStealingExecutor::WorkDeque::grow(Buffer *buffer, int64_t bottom, int64_t top)
+{
+    auto *bigger = new Buffer(buffer->capacity * 2);
+    for (int64_t i = top; i < bottom; ++i)
+        bigger->put(i, buffer->get(i));
+    retired_.emplace_back(buffer);
+    buffer_.store(bigger, std::memory_order_release);
+    return bigger;
+}
+
+///////////*//////////     线程池    //////////*///////////
+
+WorkStealingExecutor::WorkStealingExecutor(size_t threads)
+{
+    threads = std::max<size_t>(threads, 1);
+    // 先创建全部工作线程的队列，线程启动后即可能相互窃取
+    for (size_t i = 0; i < threads; ++i)
+    {
+        auto worker = std::make_unique<Worker>();
+        worker->index = i;
+        worker->rng = static_cast<uint32_t>(i * 2654435761u + 1);
+        workers_.push_back(std::move(worker));
+    }
+    for (auto &worker : workers_)
+        worker->thread = std::thread(&WorkStealingExecutor::run, this, std::ref(*worker));
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+        stopping_.store(true);
+        for (auto &worker : workers_)
+            worker->cv.notify_one();
+    }
+    for (auto &worker : workers_)
+    {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+
+    // 丢弃未执行的任务
+    for (auto &worker : workers_)
+    {
+        while (TaskEntry *entry = worker->deque.steal())
+            delete entry;
+    }
+    for (TaskEntry *entry : injected_)
+        delete entry;
+}
+
+bool WorkStealingExecutor::submit(Task task)
+{
+    if (stopping_.load(std::memory_order_relaxed))
+        return false;
+
+    auto *entry = new TaskEntry{std::move(task)};
+    if (t_executor == this)
+    {
+        // 任务内派生的任务：放入本线程队列，由本线程后进先出地执行或被其他线程窃取
+        workers_[t_index]->deque.push(entry);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        injected_.push_back(entry);
+        injected_size_.fetch_add(1);
+    }
+    notifyOne();
+    return true;
+}
+
+void WorkStealingExecutor::execute(TaskEntry *entry)
+{
+    try
+    {
+        entry->task();
+    }
+    catch (...)
+    {
+        // 捕获所有异常，防止线程因异常退出
+    }
+    delete entry;
+}
+
+bool WorkStealingExecutor::hasWork() const
+{
+    if (injected_size_.load() > 0)
+        return true;
+    for (const auto &worker : workers_)
+    {
+        if (!worker->deque.empty())
+            return true;
+    }
+    return false;
+}
+
+void WorkStealingExecutor::notifyOne()
+{
+    // 与 park 中"登记休眠后再检查任务"配对：要么这里看到休眠线程，要么休眠前的检查看到新任务
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (searching_.load() > 0 || parked_count_.load() == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    if (searching_.load() > 0 || parked_.empty())
+        return;
+    size_t index = parked_.back();
+    parked_.pop_back();
+    parked_count_.fetch_sub(1);
+    // 被唤醒的线程直接进入搜索状态，期间的提交不再重复唤醒
+    searching_.fetch_add(1);
+    workers_[index]->notified = true;
+    workers_[index]->cv.notify_one();
+}
+
+bool WorkStealingExecutor::park(Worker &worker)
+{
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    if (stopping_.load())
+        return false;
+    parked_.push_back(worker.index);
+    parked_count_.fetch_add(1);
+    searching_.fetch_sub(1);
+    lock.unlock();
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (hasWork())
+    {
+        // 登记休眠期间有新任务：撤销登记（若已被唤醒，唤醒方已计入搜索数）
+        lock.lock();
+        if (!worker.notified)
+        {
+            parked_.erase(std::find(parked_.begin(), parked_.end(), worker.index));
+            parked_count_.fetch_sub(1);
+            searching_.fetch_add(1);
+        }
+        worker.notified = false;
+        return true;
+    }
+
+    lock.lock();
+    worker.cv.wait(lock, [this, &worker] { return worker.notified || stopping_.load(); });
+    worker.notified = false;
+    return !stopping_.load();
+}
+
+WorkStealingExecutor::TaskEntry *WorkStealingExecutor::takeInjected(Worker &worker)
+{
+    if (injected_size_.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(inject_mutex_);
+    if (injected_.empty())
+        return nullptr;
+    // 按线程数均分，其余线程可从本线程队列窃取
+    size_t count = std::min(INJECT_BATCH, injected_.size() / workers_.size() + 1);
+    TaskEntry *first = injected_.front();
+    injected_.pop_front();
+    for (size_t i = 1; i < count; ++i)
+    {
+        worker.deque.push(injected_.front());
+        injected_.pop_front();
+    }
+    injected_size_.fetch_sub(count);
+    return first;
+}
+
+WorkStealingExecutor::TaskEntry *WorkStealingExecutor::stealFromOthers(Worker &worker)
+{
+    size_t count = workers_.size();
+    if (count < 2)
+        return nullptr;
+
+    // xorshift 随机起点，避免所有线程从同一个目标开始窃取
+    worker.rng ^= worker.rng << 13;
+    worker.rng ^= worker.rng >> 17;
+    worker.rng ^= worker.rng << 5;
+    size_t start = worker.rng % count;
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t victim = (start + i) % count;
+        if (victim == worker.index)
+            continue;
+        if (TaskEntry *entry = workers_[victim]->deque.steal())
+            return entry;
+    }
+    return nullptr;
+}
+
+void WorkStealingExecutor::run(Worker &worker)
+{
+    t_executor = this;
+    t_index = worker.index;
+    bool searching = false;
+
+    while (!stopping_.load(std::memory_order_relaxed))
+    {
+        TaskEntry *entry = worker.deque.take();
+        if (!entry)
+        {
+            if (!searching)
+            {
+                searching = true;
+                searching_.fetch_add(1);
+            }
+            for (int round = 0; round < SEARCH_ROUNDS && !entry; ++round)
+            {
+                entry = takeInjected(worker);
+                if (!entry)
+                    entry = stealFromOthers(worker);
+                if (!entry && round + 1 < SEARCH_ROUNDS)
+                    std::this_thread::yield();
+            }
+            if (!entry)
+            {
+                // park 返回时已处于搜索状态（由唤醒方或撤销休眠时计入）
+                if (!park(worker))
+                    break;
+                continue;
+            }
+        }
+
+        if (searching)
+        {
+            searching = false;
+            // 最后一个搜索线程找到了任务，可能还有更多任务：唤醒下一个线程接替搜索
+            if (searching_.fetch_sub(1) == 1)
+                notifyOne();
+        }
+        execute(entry);
+    }
+
+    t_executor = nullptr;
+}
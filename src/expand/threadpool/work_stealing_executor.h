@@ -0,0 +1,132 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        work_stealing_executor.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 任务窃取线程池（跨平台，仅依赖标准库）
+    1. 每个工作线程一个 Chase–Lev 双端队列：本线程在底部压入/取出（无锁、无CAS，仅剩最后一个任务时一次CAS），
+       其他线程从顶部窃取
+    2. 外部线程（如接收线程）提交的任务进入全局注入队列，工作线程一次取走一批，首个立即执行，其余放入自己的
+       双端队列供空闲线程窃取，注入队列的锁每批只竞争一次
+    3. 空闲线程先以"搜索"状态轮询窃取，找不到任务时登记到休眠栈并在各自的条件变量上等待；
+       提交任务时若已有线程在搜索则不唤醒，否则只唤醒一个休眠线程（不广播），
+       搜索到任务的最后一个搜索线程再唤醒下一个，随负载逐个扩展并行度
+    4. 销毁时停止全部线程，未执行的任务直接丢弃（与 threadpool_destroy 不处理 pending 任务一致）
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef WORK_STEALING_EXECUTOR_H_
+#define WORK_STEALING_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingExecutor
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingExecutor(size_t threads);
+    ~WorkStealingExecutor();
+
+    WorkStealingExecutor(const WorkStealingExecutor &) = delete;
+    WorkStealingExecutor &operator=(const WorkStealingExecutor &) = delete;
+
+    // 提交任务：工作线程内提交的进入本线程双端队列，其余进入注入队列；已停止时返回false
+    bool submit(Task task);
+
+    size_t threadCount() const { return workers_.size(); }
+
+private:
+    struct TaskEntry
+    {
+        Task task;
+    };
+
+    // Chase–Lev 双端队列（Lê et al. 2013 的 C11 内存序版本），容量不足时由属主线程扩容
+    class WorkDeque
+    {
+    public:
+        WorkDeque();
+        ~WorkDeque();
+
+        // 以下两个仅属主线程调用
+        void push(TaskEntry *entry);
+        TaskEntry *take();
+        // 任意线程调用，为空或与其他线程竞争失败时返回空
+        TaskEntry *steal();
+        bool empty() const;
+
+    private:
+        struct Buffer
+        {
+            explicit Buffer(int64_t capacity);
+            int64_t capacity;
+            std::unique_ptr<std::atomic<TaskEntry *>[]> slots;
+            TaskEntry *get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+            void put(int64_t i, TaskEntry *entry) { slots[i & (capacity - 1)].store(entry, std::memory_order_relaxed); }
+        };
+
+        Buffer *grow(Buffer *buffer, int64_t bottom, int64_t top);
+
+        alignas(64) std::atomic<int64_t> top_{0};
+        alignas(64) std::atomic<int64_t> bottom_{0};
+        std::atomic<Buffer *> buffer_;
+        // 扩容前的旧缓冲可能仍被窃取线程读取，析构时统一释放
+        std::vector<std::unique_ptr<Buffer>> retired_;
+    };
+
+    struct alignas(64) Worker
+    {
+        size_t index = 0;
+        WorkDeque deque;
+        std::condition_variable cv;     // 休眠等待（与 park_mutex_ 配合）
+        bool notified = false;          // 被指定唤醒（park_mutex_ 保护）
+        uint32_t rng = 0;               // 选择窃取目标的随机数状态
+        std::thread thread;
+    };
+
+    // 注入队列每次最多取走的任务数
+    static constexpr size_t INJECT_BATCH = 32;
+    // 休眠前搜索任务的轮数
+    static constexpr int SEARCH_ROUNDS = 4;
+
+    void run(Worker &worker);
+    TaskEntry *takeInjected(Worker &worker);
+    TaskEntry *stealFromOthers(Worker &worker);
+    bool hasWork() const;
+    // 有新任务：没有线程在搜索时唤醒一个休眠线程
+    void notifyOne();
+    // 找不到任务时休眠，返回false表示已停止
+    bool park(Worker &worker);
+    static void execute(TaskEntry *entry);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // 全局注入队列
+    std::mutex inject_mutex_;
+    std::deque<TaskEntry *> injected_;
+    std::atomic<size_t> injected_size_{0};
+
+    // 休眠与唤醒
+    std::mutex park_mutex_;
+    std::vector<size_t> parked_;        // 休眠线程栈，后休眠的先唤醒（缓存更热）
+    std::atomic<size_t> parked_count_{0};
+    std::atomic<int> searching_{0};     // 正在搜索任务的线程数（含已被唤醒、尚未开始搜索的线程）
+    std::atomic<bool> stopping_{false};
+};
+
+#endif // WORK_STEALING_EXECUTOR_H_
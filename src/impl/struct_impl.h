@@ -14,13 +14,32 @@ Version history
 
 #pragma once
 
+#include <cstdint>
+
 /* 当前库默认应用层扩展头（tcp，udp传输层差异内容不做扩展 */
 #pragma pack(push, 1)       // 强制一字节对齐（消除成员间填充字节）
 struct PacketHeader
 {
     uint16_t seq;           // 序列号
-    uint32_t checksum;      // CRC32校验
+    uint32_t checksum;      // 校验值（网络字节序），覆盖包头（本字段按0计算）及其后 payload_len 范围内的数据
+    uint8_t checksum_type;  // 校验算法（communicate::ChecksumType），0 为不校验
     uint64_t timestamp;     // 时间戳
     uint16_t payload_len;   // 数据长度（header + data）
 };
-#pragma pack(pop)
\ No newline at end of file
+#pragma pack(pop)
+
+/* UDP 分片头：超过 max_send_packet_size 的消息切分为多个数据报，接收端按消息编号重组（多字节字段均为网络字节序） */
+#pragma pack(push, 1)
+struct FragmentHeader
+{
+    PacketHeader packet;    // seq 为消息编号低16位，payload_len 为本数据报长度（分片头 + 分片数据），校验覆盖整个数据报
+    uint16_t magic;         // 固定为 FRAGMENT_MAGIC，用于识别未携带分片头的数据报
+    uint32_t msg_id;        // 消息编号（同一发送端内递增）
+    uint16_t frag_index;    // 分片序号，从0开始
+    uint16_t frag_count;    // 分片总数
+    uint32_t total_len;     // 消息总长度（不含分片头）
+    uint32_t offset;        // 本分片数据在消息中的偏移
+};
+#pragma pack(pop)
+
+constexpr uint16_t FRAGMENT_MAGIC = 0x4652;     // "FR"
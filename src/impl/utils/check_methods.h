@@ -10,40 +10,55 @@ Version history
 
 [序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
 1             2025-03-18      cjx        create
+2                                        校验算法由包头指定，改用按CPU能力选择实现的校验引擎
 
 *****************************************************************/
 
 #pragma once
 
+#ifdef _WIN32
+#include <winsock2.h>
+#else
 #include <arpa/inet.h>
-#include <zlib.h>
+#endif
 
 #include "struct_impl.h"
+#include "checksum.h"
 
 namespace communicate
 {
 
-uint32_t calculate_checksum(const void *data, size_t len)
+/**
+ * @brief 按包头指定的算法计算校验值（网络字节序）
+ * @param header    包头，其 checksum 字段按0参与计算
+ * @param payload   紧随包头的数据，长度为 payload_len - sizeof(PacketHeader)
+ */
+inline uint32_t calculate_checksum(const PacketHeader &header, const void *payload)
 {
-    return htonl(crc32(0L, reinterpret_cast<const Bytef *>(data), len));
+    ChecksumType type = static_cast<ChecksumType>(header.checksum_type);
+    PacketHeader zeroed = header;
+    zeroed.checksum = 0;
+    uint32_t crc = checksum(type, &zeroed, sizeof(PacketHeader));
+
+    size_t total = ntohs(header.payload_len);
+    if (payload && total > sizeof(PacketHeader))
+        crc = checksum(type, payload, total - sizeof(PacketHeader), crc);
+    return htonl(crc);
 }
 
-bool validate_packet(const PacketHeader &header, const char *payload)
+// 校验数据包；未校验（NONE）的包视为通过，未知算法视为失败
+inline bool validate_packet(const PacketHeader &header, const void *payload)
 {
-    // 校验头部
-    uint32_t received_checksum = ntohl(header.checksum);
-    uint32_t actual_checksum = calculate_checksum(&header, sizeof(PacketHeader) - sizeof(uint32_t));
-
-    // 校验载荷（若存在）
-    if (payload && ntohs(header.payload_len) > 0)
+    switch (static_cast<ChecksumType>(header.checksum_type))
     {
-        actual_checksum = crc32(actual_checksum,
-                                reinterpret_cast<const Bytef *>(payload),
-                                ntohs(header.payload_len));
+    case ChecksumType::NONE:
+        return true;
+    case ChecksumType::CRC32:
+    case ChecksumType::CRC32C:
+        return header.checksum == calculate_checksum(header, payload);
+    default:
+        return false;
     }
-
-    return (received_checksum == actual_checksum);
 }
 
-
-}   // communicate
\ No newline at end of file
+}   // communicate
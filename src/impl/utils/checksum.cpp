@@ -0,0 +1,330 @@
+#include "checksum.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CHECKSUM_X86_64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CHECKSUM_TARGET(features) __attribute__((target(features)))
+#else
+#define CHECKSUM_TARGET(features)
+#endif
+
+namespace communicate
+{
+
+namespace
+{
+
+// 以下实现均处理未取反的CRC寄存器值，取反由 checksum() 统一完成
+using CrcFunc = uint32_t (*)(uint32_t state, const uint8_t *data, size_t len);
+
+constexpr uint32_t CRC32_POLY = 0xEDB88320;     // IEEE 802.3（反射）
+constexpr uint32_t CRC32C_POLY = 0x82F63B78;    // Castagnoli（反射）
+
+// slicing-by-8 查表：table[k][b] 为字节 b 之后再经过 k 个零字节的余数
+struct SlicingTable
+{
+    uint32_t table[8][256];
+
+    explicit SlicingTable(uint32_t poly)
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (poly & (0u - (crc & 1)));
+            table[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            for (int k = 1; k < 8; ++k)
+                table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+        }
+    }
+};
+
+const SlicingTable &crc32Table()
+{
+    static const SlicingTable table(CRC32_POLY);
+    return table;
+}
+
+const SlicingTable &crc32cTable()
+{
+    static const SlicingTable table(CRC32C_POLY);
+    return table;
+}
+
+// 按小端读取，与主机字节序无关
+inline uint32_t loadLE32(const uint8_t *p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint32_t slicing8(const SlicingTable &tables, uint32_t crc, const uint8_t *p, size_t len)
+{
+    const auto &t = tables.table;
+    while (len >= 8)
+    {
+        uint32_t one = loadLE32(p) ^ crc;
+        uint32_t two = loadLE32(p + 4);
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+              t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+        p += 8;
+        len -= 8;
+    }
+    while (len--)
+        crc = t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+uint32_t crc32Slicing8(uint32_t crc, const uint8_t *p, size_t len)
+{
+    return slicing8(crc32Table(), crc, p, len);
+}
+
+uint32_t crc32cSlicing8(uint32_t crc, const uint8_t *p, size_t len)
+{
+    return slicing8(crc32cTable(), crc, p, len);
+}
+
+#ifdef CHECKSUM_X86_64
+
+// CRC32C：SSE4.2 crc32 指令每次处理8字节
+CHECKSUM_TARGET("sse4.2")
+uint32_t crc32cSse42(uint32_t crc, const uint8_t *p, size_t len)
+{
+    uint64_t state = crc;
+    while (len >= 8)
+    {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        state = _mm_crc32_u64(state, value);
+        p += 8;
+        len -= 8;
+    }
+    crc = static_cast<uint32_t>(state);
+    while (len--)
+        crc = _mm_crc32_u8(crc, *p++);
+    return crc;
+}
+
+/**
+ * CRC32（IEEE）：PCLMULQDQ 折叠
+ * 四路128位并行折叠每次推进64字节，再合并为128位、折叠到64位，最后以Barrett约简得到32位余数
+ * （常数与流程见 Intel "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"）
+ * 要求 len 不小于64且为16的倍数
+ */
+CHECKSUM_TARGET("pclmul,sse4.1")
+uint32_t crc32PclmulBlocks(uint32_t crc, const uint8_t *p, size_t len)
+{
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 0x00));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 0x10));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 0x20));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+    p += 64;
+    len -= 64;
+
+    while (len >= 64)
+    {
+        __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 0x30)));
+        p += 64;
+        len -= 64;
+    }
+
+    // 四路合并为128位
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+    const __m128i rest[] = {x2, x3, x4};
+    for (const __m128i &next : rest)
+    {
+        __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, next), x5);
+    }
+
+    // 剩余的16字节块逐块折叠
+    while (len >= 16)
+    {
+        __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p))), x5);
+        p += 16;
+        len -= 16;
+    }
+
+    // 128位折叠到64位
+    __m128i t = _mm_clmulepi64_si128(x1, x0, 0x10);
+    const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), t);
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+    t = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, t);
+
+    // Barrett 约简到32位
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+    t = _mm_and_si128(x1, mask);
+    t = _mm_clmulepi64_si128(t, x0, 0x10);
+    t = _mm_and_si128(t, mask);
+    t = _mm_clmulepi64_si128(t, x0, 0x00);
+    x1 = _mm_xor_si128(x1, t);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+uint32_t crc32Pclmul(uint32_t crc, const uint8_t *p, size_t len)
+{
+    if (len >= 64)
+    {
+        size_t blocks = len & ~static_cast<size_t>(15);
+        crc = crc32PclmulBlocks(crc, p, blocks);
+        p += blocks;
+        len -= blocks;
+    }
+    return crc32Slicing8(crc, p, len);
+}
+
+struct CpuFeatures
+{
+    bool sse42 = false;
+    bool pclmul = false;    // 同时要求 SSE4.1（_mm_extract_epi32）
+};
+
+CpuFeatures detectCpu()
+{
+    CpuFeatures features;
+#ifdef _MSC_VER
+    int info[4] = {};
+    __cpuid(info, 1);
+    features.sse42 = (info[2] & (1 << 20)) != 0;
+    features.pclmul = (info[2] & (1 << 1)) != 0 && (info[2] & (1 << 19)) != 0;
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    features.sse42 = __builtin_cpu_supports("sse4.2");
+    features.pclmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+    return features;
+}
+
+#endif // CHECKSUM_X86_64
+
+// 进程内首次使用时按CPU能力选定各算法的实现
+struct Engine
+{
+    CrcFunc crc32 = &crc32Slicing8;
+    CrcFunc crc32c = &crc32cSlicing8;
+    const char *crc32_name = "slicing-by-8";
+    const char *crc32c_name = "slicing-by-8";
+
+    Engine()
+    {
+#ifdef CHECKSUM_X86_64
+        CpuFeatures cpu = detectCpu();
+        if (cpu.pclmul)
+        {
+            crc32 = &crc32Pclmul;
+            crc32_name = "pclmul";
+        }
+        if (cpu.sse42)
+        {
+            crc32c = &crc32cSse42;
+            crc32c_name = "sse4.2";
+        }
+#endif
+    }
+};
+
+const Engine &engine()
+{
+    static const Engine instance;
+    return instance;
+}
+
+}   // namespace
+
+uint32_t checksum(ChecksumType type, const void *data, size_t len, uint32_t crc)
+{
+    const auto *p = static_cast<const uint8_t *>(data);
+    switch (type)
+    {
+    case ChecksumType::CRC32:
+        return ~engine().crc32(~crc, p, len);
+    case ChecksumType::CRC32C:
+        return ~engine().crc32c(~crc, p, len);
+    default:
+        return 0;
+    }
+}
+
+uint32_t checksum_portable(ChecksumType type, const void *data, size_t len, uint32_t crc)
+{
+    const auto *p = static_cast<const uint8_t *>(data);
+    switch (type)
+    {
+    case ChecksumType::CRC32:
+        return ~crc32Slicing8(~crc, p, len);
+    case ChecksumType::CRC32C:
+        return ~crc32cSlicing8(~crc, p, len);
+    default:
+        return 0;
+    }
+}
+
+const char *checksum_implementation(ChecksumType type)
+{
+    switch (type)
+    {
+    case ChecksumType::CRC32:
+        return engine().crc32_name;
+    case ChecksumType::CRC32C:
+        return engine().crc32c_name;
+    default:
+        return "none";
+    }
+}
+
+bool parse_checksum_type(const std::string &name, ChecksumType &type)
+{
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "none" || lower.empty())
+        type = ChecksumType::NONE;
+    else if (lower == "crc32")
+        type = ChecksumType::CRC32;
+    else if (lower == "crc32c")
+        type = ChecksumType::CRC32C;
+    else
+        return false;
+    return true;
+}
+
+}   // communicate
@@ -0,0 +1,51 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        checksum.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: 数据包校验值计算（运行时按CPU能力选择实现）
+    1. CRC32（IEEE 802.3，与 zlib crc32 结果一致）：支持 PCLMULQDQ 时以无进位乘法折叠，否则查表
+    2. CRC32C（Castagnoli）：支持 SSE4.2 时使用 crc32 指令，否则查表
+    3. 查表实现为 slicing-by-8，每次处理8字节
+    所用算法记录在包头（PacketHeader::checksum_type），接收端按包头选择算法，收发两端无需配置一致
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace communicate
+{
+
+// 校验算法（取值写入包头，不可更改已有取值）
+enum class ChecksumType : uint8_t
+{
+    NONE = 0,       // 不校验
+    CRC32 = 1,      // IEEE 802.3 多项式
+    CRC32C = 2,     // Castagnoli 多项式，x86 上有专用指令
+};
+
+/**
+ * @brief 计算校验值，crc 传入前一段的结果即可分段累加（用法同 zlib crc32）
+ * @note NONE 及未知算法返回0
+ */
+uint32_t checksum(ChecksumType type, const void *data, size_t len, uint32_t crc = 0);
+
+// 纯软件实现（slicing-by-8），供对照测试与基准测试使用
+uint32_t checksum_portable(ChecksumType type, const void *data, size_t len, uint32_t crc = 0);
+
+// 当前CPU上该算法使用的实现名称（"pclmul"、"sse4.2"、"slicing-by-8"、"none"）
+const char *checksum_implementation(ChecksumType type);
+
+// 配置名称（"none"、"crc32"、"crc32c"，不区分大小写）转换为算法，未知名称返回false
+bool parse_checksum_type(const std::string &name, ChecksumType &type);
+
+}   // communicate
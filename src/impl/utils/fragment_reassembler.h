@@ -0,0 +1,397 @@
+/***************************************************************
+Copyright (c) 2022-2030, shisan233@sszc.live.
+SPDX-License-Identifier: MIT
+File:        fragment_reassembler.h
+Version:     1.0
+Author:      cjx
+start date:
+Description: UDP 大消息的分片封装与接收端重组（双端均部署该库时使用）
+    1. 发送端为每个分片在数据前插入 FragmentHeader，分片数据仍引用调用方缓冲（iovec），不做拷贝；
+       指定校验算法时逐分片计算校验值，接收端校验失败的分片直接丢弃
+    2. 接收端按 (发送方, 消息编号) 收集分片，分片数据按偏移直接写入同一块池化缓冲，
+       收齐后该缓冲整块交给订阅者，无需再次拼接
+    3. 未完成的消息超时后丢弃；所有未完成消息占用的缓冲总量受上限约束，超出时淘汰最早的消息
+       （另有各尺寸级别少量缓存的空闲缓冲）
+    重组器非线程安全，每个接收线程持有一个
+Version history
+
+[序号]    |   [修改日期]  |   [修改者]   |   [修改内容]
+
+*****************************************************************/
+
+#ifndef FRAGMENT_REASSEMBLER_H_
+#define FRAGMENT_REASSEMBLER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#include <sys/uio.h>
+#endif
+
+#include "communicate_api.h"
+#include "struct_impl.h"
+#include "utils/buffer_pool.h"
+#include "utils/check_methods.h"
+
+// 发送端分片封装：一条消息的 iovec 转换为 [分片头, 分片数据...] 序列，每 packet_size 字节恰为一个数据报
+class FragmentFramer
+{
+public:
+    using iovec = communicate::iovec;
+
+    // 分片头及按发送顺序排列的 iovec（分片头与调用方数据交替）
+    struct Frames
+    {
+        std::vector<FragmentHeader> headers;
+        std::vector<iovec> iov;
+        size_t size = 0;        // 封装后的总字节数
+    };
+
+    /**
+     * @brief 按 packet_size 封装一条消息
+     * @param packet_size   单个数据报大小（含分片头），须大于分片头长度
+     * @param checksum_type 分片校验算法，NONE 为不校验
+     * @return 消息过大（分片数超过65535）或 packet_size 过小时返回false
+     */
+    static bool frame(const iovec *iov, size_t iovcnt, size_t size, size_t packet_size, uint32_t msg_id,
+                      communicate::ChecksumType checksum_type, Frames &frames)
+    {
+        if (packet_size <= sizeof(FragmentHeader) || size > UINT32_MAX)
+            return false;
+        const size_t chunk = packet_size - sizeof(FragmentHeader);
+        const size_t count = size == 0 ? 1 : (size + chunk - 1) / chunk;
+        if (count > UINT16_MAX)
+            return false;
+
+        frames.headers.resize(count);
+        frames.iov.clear();
+        frames.iov.reserve(count * 2 + iovcnt);
+        frames.size = size + count * sizeof(FragmentHeader);
+
+        uint64_t timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        size_t index = 0, inner = 0;    // 当前 iovec 及其内偏移
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t offset = i * chunk;
+            size_t length = std::min(chunk, size - offset);
+
+            FragmentHeader &header = frames.headers[i];
+            header.packet.seq = htons(static_cast<uint16_t>(msg_id));
+            header.packet.checksum = 0;
+            header.packet.checksum_type = static_cast<uint8_t>(checksum_type);
+            header.packet.timestamp = hton64(timestamp);
+            header.packet.payload_len = htons(static_cast<uint16_t>(sizeof(FragmentHeader) + length));
+            header.magic = htons(FRAGMENT_MAGIC);
+            header.msg_id = htonl(msg_id);
+            header.frag_index = htons(static_cast<uint16_t>(i));
+            header.frag_count = htons(static_cast<uint16_t>(count));
+            header.total_len = htonl(static_cast<uint32_t>(size));
+            header.offset = htonl(static_cast<uint32_t>(offset));
+            size_t first = frames.iov.size();
+            frames.iov.push_back({&header, sizeof(FragmentHeader)});
+
+            // 分片数据可跨越 iovec 边界
+            while (length > 0)
+            {
+                size_t take = std::min(length, iov[index].iov_len - inner);
+                if (take > 0)
+                    frames.iov.push_back({static_cast<char *>(iov[index].iov_base) + inner, take});
+                length -= take;
+                inner += take;
+                if (inner == iov[index].iov_len)
+                {
+                    ++index;
+                    inner = 0;
+                }
+            }
+
+            // 校验覆盖整个数据报（分片头中 checksum 字段按0计算）
+            if (checksum_type != communicate::ChecksumType::NONE)
+            {
+                uint32_t crc = 0;
+                for (size_t k = first; k < frames.iov.size(); ++k)
+                    crc = communicate::checksum(checksum_type, frames.iov[k].iov_base, frames.iov[k].iov_len, crc);
+                header.packet.checksum = htonl(crc);
+            }
+        }
+        return true;
+    }
+
+    static uint64_t hton64(uint64_t value)
+    {
+        return (static_cast<uint64_t>(htonl(static_cast<uint32_t>(value))) << 32) | htonl(static_cast<uint32_t>(value >> 32));
+    }
+};
+
+// 接收端重组
+class FragmentReassembler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 解析后的分片头（主机字节序）
+    struct Fragment
+    {
+        uint32_t msg_id = 0;
+        uint16_t index = 0;
+        uint16_t count = 0;
+        uint32_t total_len = 0;
+        uint32_t offset = 0;
+        const char *data = nullptr;
+        size_t len = 0;
+    };
+
+    enum class Result
+    {
+        NOT_FRAGMENT,   // 未携带分片头，按原始数据报处理
+        COMPLETE,       // 消息已完整（单分片消息或最后一个分片到达）
+        PENDING,        // 等待其余分片
+        DROPPED,        // 分片头非法、校验失败、消息超过上限或重复分片
+    };
+
+    struct Stats
+    {
+        uint64_t completed = 0;
+        uint64_t expired = 0;   // 超时丢弃的未完成消息
+        uint64_t evicted = 0;   // 因内存上限淘汰的未完成消息
+        uint64_t dropped = 0;
+        uint64_t corrupted = 0; // 校验失败的分片（同时计入 dropped）
+    };
+
+    /**
+     * @param max_message_size  可重组的最大消息长度
+     * @param max_pending_bytes 未完成消息占用的缓冲总量上限
+     * @param timeout_ms        消息首个分片到达后等待其余分片的时长
+     */
+    FragmentReassembler(size_t max_message_size, size_t max_pending_bytes, int timeout_ms)
+        : max_message_size_(max_message_size), max_pending_bytes_(max_pending_bytes),
+          timeout_(std::chrono::milliseconds(timeout_ms > 0 ? timeout_ms : 1)) {}
+
+    ~FragmentReassembler()
+    {
+        for (auto &entry : entries_)
+            entry.pool->release(entry.buffer);
+    }
+
+    FragmentReassembler(const FragmentReassembler &) = delete;
+    FragmentReassembler &operator=(const FragmentReassembler &) = delete;
+
+    // 解析数据报头部的分片头，长度、魔数或字段不一致时视为普通数据报
+    static bool parse(const char *data, size_t len, Fragment &fragment)
+    {
+        if (len < sizeof(FragmentHeader))
+            return false;
+        FragmentHeader header;
+        memcpy(&header, data, sizeof(header));
+        if (ntohs(header.magic) != FRAGMENT_MAGIC || ntohs(header.packet.payload_len) != len)
+            return false;
+
+        fragment.msg_id = ntohl(header.msg_id);
+        fragment.index = ntohs(header.frag_index);
+        fragment.count = ntohs(header.frag_count);
+        fragment.total_len = ntohl(header.total_len);
+        fragment.offset = ntohl(header.offset);
+        fragment.data = data + sizeof(FragmentHeader);
+        fragment.len = len - sizeof(FragmentHeader);
+        if (fragment.index >= fragment.count ||
+            static_cast<uint64_t>(fragment.offset) + fragment.len > fragment.total_len)
+            return false;
+        return fragment.count > 1 || fragment.len == fragment.total_len;
+    }
+
+    /**
+     * @brief 处理一个数据报
+     * @param src_key   发送方键（同一发送方的消息编号唯一）
+     * @param message   COMPLETE 时为完整消息：单分片消息为原缓冲的别名视图，多分片消息为重组缓冲
+     */
+    Result add(uint64_t src_key, const std::shared_ptr<void> &datagram, size_t len,
+               std::shared_ptr<void> &message, Clock::time_point now = Clock::now())
+    {
+        const char *data = static_cast<const char *>(datagram.get());
+        Fragment fragment;
+        if (!parse(data, len, fragment))
+            return Result::NOT_FRAGMENT;
+
+        PacketHeader packet;
+        memcpy(&packet, data, sizeof(packet));
+        if (!communicate::validate_packet(packet, data + sizeof(PacketHeader)))
+        {
+            ++stats_.corrupted;
+            ++stats_.dropped;
+            return Result::DROPPED;
+        }
+
+        expire(now);
+        if (fragment.count == 1)
+        {
+            // 单分片消息无需重组，跳过分片头直接交付
+            message = std::shared_ptr<void>(datagram, const_cast<char *>(fragment.data));
+            ++stats_.completed;
+            return Result::COMPLETE;
+        }
+        if (fragment.total_len > max_message_size_)
+        {
+            ++stats_.dropped;
+            return Result::DROPPED;
+        }
+
+        Key key{src_key, fragment.msg_id};
+        auto it = index_.find(key);
+        if (it == index_.end())
+        {
+            if (!open(key, fragment, now))
+            {
+                ++stats_.dropped;
+                return Result::DROPPED;
+            }
+            it = index_.find(key);
+        }
+
+        Entry &entry = *it->second;
+        uint64_t bit = 1ULL << (fragment.index % 64);
+        if (fragment.count != entry.count || fragment.total_len != entry.total_len ||
+            (entry.received_mask[fragment.index / 64] & bit))
+        {
+            ++stats_.dropped;
+            return Result::DROPPED;
+        }
+
+        // 分片数据按偏移直接写入重组缓冲
+        memcpy(entry.buffer + fragment.offset, fragment.data, fragment.len);
+        entry.received_mask[fragment.index / 64] |= bit;
+        entry.received_bytes += fragment.len;
+        if (++entry.received < entry.count)
+            return Result::PENDING;
+
+        if (entry.received_bytes != entry.total_len)
+        {
+            // 分片数与长度不符（分片头被篡改或来自不同发送端实现）
+            close(it->second);
+            ++stats_.dropped;
+            return Result::DROPPED;
+        }
+
+        message = entry.pool->share(entry.buffer);
+        entry.buffer = nullptr;     // 缓冲已交给订阅者
+        close(it->second);
+        ++stats_.completed;
+        return Result::COMPLETE;
+    }
+
+    size_t pendingMessages() const { return entries_.size(); }
+    size_t pendingBytes() const { return pending_bytes_; }
+    const Stats &stats() const { return stats_; }
+
+private:
+    static constexpr size_t MIN_CLASS_SHIFT = 12;   // 最小的缓冲尺寸级别：4KB
+    static constexpr size_t POOL_CACHED = 4;        // 每个尺寸级别缓存的空闲缓冲数
+
+    struct Key
+    {
+        uint64_t src;
+        uint32_t msg_id;
+        bool operator==(const Key &other) const { return src == other.src && msg_id == other.msg_id; }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const
+        {
+            return std::hash<uint64_t>()(key.src * 0x9E3779B97F4A7C15ULL ^ key.msg_id);
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        BufferPool *pool = nullptr;
+        char *buffer = nullptr;
+        size_t capacity = 0;            // 缓冲实际大小（计入内存上限）
+        uint32_t total_len = 0;
+        uint16_t count = 0;
+        uint16_t received = 0;
+        size_t received_bytes = 0;
+        std::vector<uint64_t> received_mask;
+        Clock::time_point deadline;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    // 新消息：按总长度选择尺寸级别取得缓冲，超出内存上限时先淘汰最早的消息
+    bool open(const Key &key, const Fragment &fragment, Clock::time_point now)
+    {
+        size_t shift = MIN_CLASS_SHIFT;
+        while ((static_cast<size_t>(1) << shift) < fragment.total_len)
+            ++shift;
+        size_t capacity = static_cast<size_t>(1) << shift;
+        if (capacity > max_pending_bytes_)
+            return false;
+        while (pending_bytes_ + capacity > max_pending_bytes_ && !entries_.empty())
+        {
+            close(entries_.begin());
+            ++stats_.evicted;
+        }
+
+        size_t level = shift - MIN_CLASS_SHIFT;
+        if (pools_.size() <= level)
+            pools_.resize(level + 1);
+        if (!pools_[level])
+            pools_[level] = BufferPool::create(capacity, POOL_CACHED);
+
+        Entry entry;
+        entry.key = key;
+        entry.pool = pools_[level].get();
+        entry.buffer = entry.pool->acquire();
+        entry.capacity = capacity;
+        entry.total_len = fragment.total_len;
+        entry.count = fragment.count;
+        entry.received_mask.assign((fragment.count + 63) / 64, 0);
+        entry.deadline = now + timeout_;
+        // 超时时长固定，按到达顺序排列即按截止时间排列
+        auto it = entries_.insert(entries_.end(), std::move(entry));
+        index_[key] = it;
+        pending_bytes_ += capacity;
+        return true;
+    }
+
+    void close(EntryList::iterator it)
+    {
+        if (it->buffer)
+            it->pool->release(it->buffer);
+        pending_bytes_ -= it->capacity;
+        index_.erase(it->key);
+        entries_.erase(it);
+    }
+
+    // 丢弃已超时的未完成消息
+    void expire(Clock::time_point now)
+    {
+        while (!entries_.empty() && entries_.front().deadline <= now)
+        {
+            close(entries_.begin());
+            ++stats_.expired;
+        }
+    }
+
+    const size_t max_message_size_;
+    const size_t max_pending_bytes_;
+    const Clock::duration timeout_;
+    size_t pending_bytes_ = 0;
+    EntryList entries_;                                             // 按首个分片到达时间排序
+    std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+    std::vector<std::shared_ptr<BufferPool>> pools_;                // 按尺寸级别（2的幂）划分的重组缓冲池
+    Stats stats_;
+};
+
+#endif // FRAGMENT_REASSEMBLER_H_
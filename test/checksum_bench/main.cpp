@@ -0,0 +1,102 @@
+#include "utils/checksum.h"
+
+#include <zlib.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace communicate;
+
+// 单次测量处理的总字节数
+constexpr size_t BYTES_PER_RUN = 256 * 1024 * 1024;
+
+// 对 size 字节的缓冲重复计算，返回吞吐量（GB/s）；sink 防止计算被优化掉
+double measure(const std::function<uint32_t(const uint8_t *, size_t, uint32_t)> &fn,
+               const std::vector<uint8_t> &buffer, size_t size, uint32_t &sink)
+{
+    size_t rounds = BYTES_PER_RUN / size + 1;
+    uint32_t crc = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; ++i)
+        crc = fn(buffer.data(), size, crc);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sink ^= crc;
+    return static_cast<double>(rounds * size) / seconds / 1e9;
+}
+
+// 用法: checksum_bench [数据长度...]
+// 默认对比 64B ~ 64KB，涵盖小包、MTU大小的分片与GSO大报文
+int main(int argc, char *argv[])
+{
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(std::strtoul(argv[i], nullptr, 10));
+    if (sizes.empty())
+        sizes = {64, 256, 1400, 4096, 65536};
+
+    size_t max_size = 0;
+    for (size_t size : sizes)
+        max_size = size > max_size ? size : max_size;
+    std::vector<uint8_t> buffer(max_size);
+    std::mt19937 rng(2025);
+    for (auto &byte : buffer)
+        byte = static_cast<uint8_t>(rng());
+
+    // 先确认各实现结果一致
+    for (size_t size : sizes)
+    {
+        uLong expected = crc32(0L, buffer.data(), static_cast<uInt>(size));
+        if (checksum(ChecksumType::CRC32, buffer.data(), size) != expected ||
+            checksum_portable(ChecksumType::CRC32, buffer.data(), size) != expected ||
+            checksum(ChecksumType::CRC32C, buffer.data(), size) !=
+                checksum_portable(ChecksumType::CRC32C, buffer.data(), size))
+        {
+            std::cerr << "校验结果不一致，长度: " << size << std::endl;
+            return -1;
+        }
+    }
+
+    struct Candidate
+    {
+        std::string name;
+        std::function<uint32_t(const uint8_t *, size_t, uint32_t)> fn;
+    };
+    std::vector<Candidate> candidates = {
+        {"zlib crc32", [](const uint8_t *p, size_t n, uint32_t c) {
+             return static_cast<uint32_t>(crc32(c, p, static_cast<uInt>(n)));
+         }},
+        {"crc32 slicing-by-8", [](const uint8_t *p, size_t n, uint32_t c) {
+             return checksum_portable(ChecksumType::CRC32, p, n, c);
+         }},
+        {std::string("crc32 ") + checksum_implementation(ChecksumType::CRC32), [](const uint8_t *p, size_t n, uint32_t c) {
+             return checksum(ChecksumType::CRC32, p, n, c);
+         }},
+        {"crc32c slicing-by-8", [](const uint8_t *p, size_t n, uint32_t c) {
+             return checksum_portable(ChecksumType::CRC32C, p, n, c);
+         }},
+        {std::string("crc32c ") + checksum_implementation(ChecksumType::CRC32C), [](const uint8_t *p, size_t n, uint32_t c) {
+             return checksum(ChecksumType::CRC32C, p, n, c);
+         }},
+    };
+
+    uint32_t sink = 0;
+    std::cout << std::left << std::setw(24) << "实现 \\ 长度(字节)";
+    for (size_t size : sizes)
+        std::cout << std::right << std::setw(10) << size;
+    std::cout << "    (GB/s)" << std::endl;
+    for (const auto &candidate : candidates)
+    {
+        std::cout << std::left << std::setw(24) << candidate.name << std::right << std::fixed << std::setprecision(2);
+        for (size_t size : sizes)
+            std::cout << std::setw(10) << measure(candidate.fn, buffer, size, sink);
+        std::cout << std::endl;
+    }
+    std::cout << "(sink " << std::hex << sink << ")" << std::endl;
+    return 0;
+}
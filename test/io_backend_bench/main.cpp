@@ -0,0 +1,82 @@
+#include "communicate_api.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+using namespace communicate;
+
+// 配置文件中监听的本地回环端口
+constexpr int BENCH_PORT = 40001;
+
+std::atomic<long> recv_count(0);
+
+class CountHandler : public SubscribebBase
+{
+public:
+    int handleMsg(std::shared_ptr<void>) override
+    {
+        recv_count.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+};
+
+// 用法: io_backend_bench [配置文件] [发送包数] [包大小]
+// 分别使用 poll.yaml / io_uring.yaml 运行，对比回环下的收包速率
+int main(int argc, char *argv[])
+{
+    const char *cfg_path = argc > 1 ? argv[1] : "../poll.yaml";
+    long total = argc > 2 ? std::atol(argv[2]) : 200000;
+    size_t payload_size = argc > 3 ? std::atol(argv[3]) : 64;
+
+    if (Initialize(cfg_path))
+    {
+        std::cerr << "API初始化失败" << std::endl;
+        return -1;
+    }
+
+    if (Subscribe(new CountHandler()))
+    {
+        std::cerr << "订阅失败" << std::endl;
+        Destroy();
+        return -1;
+    }
+    // 等待接收线程就绪
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<char> payload(payload_size, 'x');
+    long send_failed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < total; ++i)
+    {
+        if (SendGeneralMessage("127.0.0.1", BENCH_PORT, payload.data(), payload.size()))
+            ++send_failed;
+    }
+    auto send_end = std::chrono::steady_clock::now();
+
+    // 等待接收完成（连续200ms无新数据视为结束）
+    long last = -1;
+    auto recv_end = send_end;
+    while (recv_count.load() != last)
+    {
+        last = recv_count.load();
+        recv_end = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    double send_sec = std::chrono::duration<double>(send_end - start).count();
+    double recv_sec = std::chrono::duration<double>(recv_end - start).count();
+    std::cout << "配置: " << cfg_path << ", 包大小: " << payload_size << " 字节" << std::endl;
+    std::cout << "发送: " << total - send_failed << "/" << total << " 包, "
+              << static_cast<long>((total - send_failed) / send_sec) << " 包/秒" << std::endl;
+    std::cout << "接收: " << last << " 包, "
+              << static_cast<long>(last / recv_sec) << " 包/秒" << std::endl;
+
+    Destroy();
+    return 0;
+}